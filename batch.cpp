@@ -0,0 +1,1078 @@
+/**
+  Name: batch.cpp
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Batch mode. See batch.h.
+*/
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "batch.h"
+#include "canonical.h"
+#include "corpus.h"
+#include "grader.h"
+#include "packed.h"
+#include "pool.h"
+#include "search.h"
+#include "simd.h"
+#include "sized.h"
+
+using namespace std;
+
+const size_t CHUNK_BYTES = 64 * 1024;      // input handed out at a time
+const size_t PART_BYTES = 48 * (CELLS + 1); // about 48 puzzles, one task
+const long CHUNKS_PER_WORKER = 8;          // chunks read ahead per worker
+
+/// A run of whole lines of a chunk, solved by one worker as one task
+struct Part
+{
+    const char *data;               // the lines, inside the chunk's
+    size_t size;
+    long firstLine;                 // line number of the first line
+    bool packed;                    // records of a packed file, not lines
+    vector<size_t> starts;          // where each puzzle line starts in data
+    vector<size_t> lengths;         // and how long it is, without newline
+    vector<long> lineNumbers;       // line number of each puzzle line
+    string output;                  // what to write to out
+    string errors;                  // what to write to cerr
+    BatchTotals totals;
+};
+
+/// A run of whole lines from the input, written out as one. Its parts are
+/// solved on their own, so a hard puzzle only holds up its own part while
+/// the other workers take the rest.
+struct Chunk
+{
+    long index;                     // position in the input, from 0
+    const char *data;               // the lines, in the mapping or in text
+    size_t size;
+    long firstLine;                 // line number of the first line
+    bool packed;                    // records of a packed file, not lines
+    string text;                    // the lines when read from a stream
+    vector<Part> parts;
+    long partsLeft;                 // parts not yet solved
+};
+
+/// Where the chunks come from: a mapped file, or a stream when in is set
+struct BatchInput
+{
+    istream *in;
+    const char *data;               // the mapped file
+    size_t size;
+    size_t offset;                  // how much of it has been handed out
+    bool packed;                    // data is the records of a packed file
+    string carry;                   // start of a line read past a chunk
+    long lineNumber;                // lines handed out so far
+};
+
+/// Puzzles waiting to be solved together by the LOCKSTEP engine
+struct LaneGroup
+{
+    Board board[LANES];
+    long lineNumber[LANES];
+    bool valid[LANES];              // false if the numbers given clash
+    int count;
+};
+
+
+
+/******************************************************************************/
+/**
+
+ Makes an empty chunk.
+
+**/
+/******************************************************************************/
+
+
+
+static Chunk *newChunk(long index)
+{
+    Chunk *chunk = new Chunk;
+
+    chunk->index = index;
+    chunk->data = NULL;
+    chunk->size = 0;
+    chunk->firstLine = 0;
+    chunk->packed = false;
+    chunk->partsLeft = 0;
+
+    return chunk;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Fills the chunk with the next run of whole lines of the input, about
+ CHUNK_BYTES of them. From a mapped file the chunk just points into the
+ mapping, ending at the first newline after CHUNK_BYTES. From a stream,
+ CHUNK_BYTES at a time are read into the chunk's own text and whatever comes
+ after its last newline is carried over to the next chunk. The records of a
+ packed file (packed.h) are handed out whole, with record numbers for line
+ numbers. Returns false once the input is used up.
+
+**/
+/******************************************************************************/
+
+
+
+static bool readChunk(BatchInput &input, Chunk &chunk)
+{
+    if (input.packed)
+    {
+        size_t end = min(input.offset + CHUNK_BYTES / PACKED_RECORD *
+                         PACKED_RECORD, input.size);
+
+        if (input.offset >= input.size)
+            return false;
+
+        chunk.data = input.data + input.offset;
+        chunk.size = end - input.offset;
+        chunk.packed = true;
+        chunk.firstLine = long(input.offset / PACKED_RECORD) + 1;
+
+        input.offset = end;
+
+        return true;
+    }
+    else if (input.in == NULL)
+    {
+        size_t end = min(input.offset + CHUNK_BYTES, input.size);
+        const void *newline;
+
+        if (input.offset >= input.size)
+            return false;
+
+        newline = memchr(input.data + end, '\n', input.size - end);
+        end = newline ? static_cast<const char *>(newline) - input.data + 1
+                      : input.size;
+
+        chunk.data = input.data + input.offset;
+        chunk.size = end - input.offset;
+
+        input.offset = end;
+    }
+    else
+    {
+        size_t last;
+
+        chunk.text.swap(input.carry);
+        input.carry.clear();
+
+
+        /// Reads until there is a newline past the first CHUNK_BYTES, in
+        /// case a line is longer than that
+        do
+        {
+            size_t have = chunk.text.size();
+
+            if (!*input.in)
+                break;
+
+            chunk.text.resize(have + CHUNK_BYTES);
+            input.in->read(&chunk.text[have], CHUNK_BYTES);
+            chunk.text.resize(have + size_t(input.in->gcount()));
+        }
+        while (chunk.text.find('\n') == string::npos);
+
+        if (chunk.text.empty())
+            return false;
+
+        last = chunk.text.rfind('\n');
+
+        if (*input.in && last != string::npos)
+        {
+            input.carry.assign(chunk.text, last + 1, string::npos);
+            chunk.text.resize(last + 1);
+        }
+
+        chunk.data = chunk.text.data();
+        chunk.size = chunk.text.size();
+    }
+
+    chunk.firstLine = input.lineNumber + 1;
+    input.lineNumber += count(chunk.data, chunk.data + chunk.size, '\n');
+
+    return true;
+}// end static bool readChunk(BatchInput &input, Chunk &chunk)
+
+
+
+/******************************************************************************/
+/**
+
+ Cuts a chunk into parts of whole lines, about PART_BYTES each, the same
+ way readChunk() cuts the input, or of as many whole records of a packed
+ chunk.
+
+**/
+/******************************************************************************/
+
+
+
+static void cutParts(Chunk &chunk)
+{
+    size_t offset = 0;
+    long lineNumber = chunk.firstLine;
+    Part part;
+
+    part.packed = chunk.packed;
+    part.totals = BatchTotals();
+
+    while (offset < chunk.size)
+    {
+        size_t end = min(offset + PART_BYTES, chunk.size);
+
+        if (chunk.packed)
+            end = min(offset + PART_BYTES / PACKED_RECORD * PACKED_RECORD,
+                      chunk.size);
+        else
+        {
+            const void *newline = memchr(chunk.data + end, '\n',
+                                         chunk.size - end);
+
+            end = newline ? static_cast<const char *>(newline) - chunk.data + 1
+                          : chunk.size;
+        }
+
+        part.data = chunk.data + offset;
+        part.size = end - offset;
+        part.firstLine = lineNumber;
+
+        chunk.parts.push_back(part);
+
+        lineNumber += chunk.packed ? long(part.size / PACKED_RECORD)
+                                   : count(part.data, part.data + part.size,
+                                           '\n');
+        offset = end;
+    }
+
+    chunk.partsLeft = long(chunk.parts.size());
+}// end static void cutParts(Chunk &chunk)
+
+
+
+/******************************************************************************/
+/**
+
+ Finds the lines of a part, where each starts and how long it is, skipping
+ empty ones, or the records of a packed part. Done by the worker that
+ solves the part, so the thread reading the input only has to find where
+ parts end.
+
+**/
+/******************************************************************************/
+
+
+
+static void splitLines(Part &part)
+{
+    const char *line = part.data, *end = part.data + part.size;
+    long lineNumber = part.firstLine;
+
+    size_t most = part.size / (part.packed ? PACKED_RECORD : CELLS + 1) + 1;
+
+    part.starts.reserve(most);
+    part.lengths.reserve(most);
+    part.lineNumbers.reserve(most);
+
+    if (part.packed)
+    {
+        for (size_t start = 0; start < part.size; start += PACKED_RECORD)
+        {
+            part.starts.push_back(start);
+            part.lengths.push_back(PACKED_RECORD);
+            part.lineNumbers.push_back(lineNumber++);
+        }
+
+        return;
+    }
+
+    for (; line < end; lineNumber++)
+    {
+        const char *newline =
+            static_cast<const char *>(memchr(line, '\n', end - line));
+        const char *stop = newline ? newline : end;
+        const char *c = line;
+
+        while (c < stop && (*c == ' ' || *c == '\t' || *c == '\r'))
+            c++;
+
+        if (c < stop)
+        {
+            part.starts.push_back(line - part.data);
+            part.lengths.push_back(stop - line);
+            part.lineNumbers.push_back(lineNumber);
+        }
+
+        line = stop + 1;
+    }
+}// end static void splitLines(Part &part)
+
+
+
+/******************************************************************************/
+/**
+
+ Turns an engine name from the command line into an Engine. Returns false if
+ there is no engine by that name.
+
+**/
+/******************************************************************************/
+
+
+
+bool parseEngine(const string &name, Engine &engine)
+{
+    if (name == "dfs")
+        engine = DEPTH_FIRST;
+    else if (name == "dlx")
+        engine = DANCING_LINKS;
+    else if (name == "simd")
+        engine = LOCKSTEP;
+    else
+        return false;
+
+    return true;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Gets a solver ready to be used for any number of puzzles.
+
+**/
+/******************************************************************************/
+
+
+
+void initSolver(Solver &solver, Engine engine)
+{
+    solver.engine = engine;
+    solver.cache = NULL;
+
+    initBudget(solver.budget);
+
+    if (engine == DANCING_LINKS)
+        initDlx(solver.dlx);
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Solves the board with the solver's engine, within a fresh start of the
+ solver's budget. Returns SOLVE_SOLVED with the board solved,
+ SOLVE_UNSOLVABLE if there is no solution, or SOLVE_EXHAUSTED with what
+ could be placed before the budget ran out. The LOCKSTEP engine only pays
+ off on many boards at once (see solvePart()), so a board on its own goes
+ straight to depthFirst().
+
+**/
+/******************************************************************************/
+
+
+
+SolveStatus solveBoard(Solver &solver, Board &board)
+{
+    startBudget(solver.budget);
+
+    if (solver.engine == DANCING_LINKS)
+        return dlxSolve(solver.dlx, board, solver.budget);
+
+    return depthFirst(board, solver.budget);
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Fills the board from the array and solves it with solveBoard(), through
+ the solver's cache if it has one: the puzzle is put in canonical form and
+ looked up, the canonical puzzle is solved on a miss and the result cached,
+ and the solution is mapped back onto the puzzle as given. Returns the
+ status of solveBoard(), SOLVE_UNSOLVABLE if the numbers clash. hit is set
+ if the solution came from the cache. Running out of budget is not cached,
+ and through the cache leaves only the puzzle as given on the board.
+
+**/
+/******************************************************************************/
+
+
+
+SolveStatus solveArray(Solver &solver, int arr[][SIDE], Board &board,
+                       bool &hit)
+{
+    Canonical canon;
+    unsigned char solution[CELLS];
+    int values[SIDE][SIDE];
+    SolveStatus status;
+    bool solved;
+
+    hit = false;
+
+    if (solver.cache == NULL)
+    {
+        if (!initBoard(board, arr))
+            return SOLVE_UNSOLVABLE;
+
+        return solveBoard(solver, board);
+    }
+
+    canonicalize(arr, canon);
+
+    hit = lookupSolution(*solver.cache, canon.value, solution, solved);
+
+    if (!hit)
+    {
+        for (int cell = 0; cell < CELLS; cell++)
+            values[rowOf(cell)][colOf(cell)] = canon.value[cell];
+
+        status = initBoard(board, values) ? solveBoard(solver, board)
+                                          : SOLVE_UNSOLVABLE;
+
+        if (status == SOLVE_EXHAUSTED)
+        {
+            initBoard(board, arr);
+            return status;
+        }
+
+        solved = status == SOLVE_SOLVED;
+
+        for (int cell = 0; cell < CELLS; cell++)
+            solution[cell] = (unsigned char)board.value[cell];
+
+        storeSolution(*solver.cache, canon.value, solution, solved);
+    }
+
+    if (!solved)
+        return SOLVE_UNSOLVABLE;
+
+    fromCanonical(canon, solution, values);
+
+    return initBoard(board, values) ? SOLVE_SOLVED : SOLVE_UNSOLVABLE;
+}// end SolveStatus solveArray(Solver &solver, int arr[][SIDE], Board &board,
+//                             bool &hit)
+
+
+
+/******************************************************************************/
+/**
+
+ Adds the line for one puzzle to the part's output: the solution if it was
+ solved, "no solution" if it has none, or "budget exhausted" and the board
+ as far as it got. Unless options.ordered is set, the line starts with the
+ line number of the puzzle.
+
+**/
+/******************************************************************************/
+
+
+
+static void writeResult(Part &part, long lineNumber, SolveStatus status,
+                        const Board &board, const BatchOptions &options)
+{
+    char solution[CELLS];
+
+    if (!options.ordered)
+        part.output += to_string(lineNumber) + ' ';
+
+    if (status == SOLVE_SOLVED)
+    {
+        writeBoard(board, solution);
+        part.output.append(solution, CELLS);
+        part.totals.solved++;
+    }
+    else if (status == SOLVE_EXHAUSTED)
+    {
+        writeBoard(board, solution);
+        part.output += string(statusName(status)) + ' ';
+        part.output.append(solution, CELLS);
+        part.totals.exhausted++;
+    }
+    else
+    {
+        part.output += statusName(status);
+        part.totals.unsolvable++;
+    }
+
+    part.output += '\n';
+}// end static void writeResult(Part &part, long lineNumber,
+//                              SolveStatus status, const Board &board,
+//                              const BatchOptions &options)
+
+
+
+/******************************************************************************/
+/**
+
+ Solves the puzzles of a group together with solveLanes(), each search
+ within budget, and writes their lines in the order they were read. Puzzles
+ whose numbers clash are not given a lane.
+
+**/
+/******************************************************************************/
+
+
+
+static void solveGroup(LaneGroup &group, Part &part, Budget &budget,
+                       const BatchOptions &options)
+{
+    Board lanes[LANES];
+    SolveStatus status[LANES];
+    int lane[LANES], count = 0;
+
+    for (int i = 0; i < group.count; i++)
+        if (group.valid[i])
+        {
+            lane[i] = count;
+            lanes[count++] = group.board[i];
+        }
+
+    solveLanes(lanes, count, status, budget);
+
+    for (int i = 0; i < group.count; i++)
+    {
+        if (group.valid[i])
+            writeResult(part, group.lineNumber[i], status[lane[i]],
+                        lanes[lane[i]], options);
+        else
+            writeResult(part, group.lineNumber[i], SOLVE_UNSOLVABLE,
+                        group.board[i], options);
+    }
+
+    group.count = 0;
+}// end static void solveGroup(LaneGroup &group, Part &part,
+//                             Budget &budget, const BatchOptions &options)
+
+
+
+/******************************************************************************/
+/**
+
+ Solves a puzzle line of box order N other than 9x9 (sized.h) with depth
+ first search, whatever the engine, within budget, and adds its line to the
+ part's output the same way as for 9x9. Counting solutions is held to the
+ budget too.
+
+**/
+/******************************************************************************/
+
+
+
+template <int N>
+static void solveSizedLine(Part &part, size_t i, Budget &budget,
+                           const BatchOptions &options)
+{
+    const char *text = part.data + part.starts[i];
+    size_t length = part.lengths[i];
+    int values[Geometry<N>::CELLS];
+    SizedBoard<N> board;
+    char solution[Geometry<N>::CELLS];
+    SolveStatus status = SOLVE_UNSOLVABLE;
+    string error;
+    bool valid;
+
+    if (!parseSized<N>(text, length, values, error))
+    {
+        part.errors += "line " + to_string(part.lineNumbers[i]) + ": " +
+                        error + "\n";
+        part.totals.malformed++;
+        return;
+    }
+
+    part.totals.puzzles++;
+
+    if (!options.ordered)
+        part.output += to_string(part.lineNumbers[i]) + ' ';
+
+    valid = initBoard(board, values);
+
+    if (options.countLimit > 0)
+    {
+        int count = 0;
+
+        startBudget(budget);
+
+        if (valid)
+            count = countSolutions(board, options.countLimit, budget);
+
+        if (budget.exhausted)
+            part.output += string(statusName(SOLVE_EXHAUSTED)) + ' ';
+
+        part.output += to_string(count) + '\n';
+
+        if (budget.exhausted)
+            part.totals.exhausted++;
+        else if (count > 0)
+            part.totals.solved++;
+        else
+            part.totals.unsolvable++;
+
+        return;
+    }
+
+    if (valid)
+    {
+        startBudget(budget);
+        status = depthFirst(board, budget);
+    }
+
+    if (status == SOLVE_UNSOLVABLE)
+    {
+        part.output += statusName(status);
+        part.totals.unsolvable++;
+    }
+    else
+    {
+        if (status == SOLVE_EXHAUSTED)
+            part.output += string(statusName(status)) + ' ';
+
+        writeSized(board, solution);
+        part.output.append(solution, Geometry<N>::CELLS);
+
+        if (status == SOLVE_SOLVED)
+            part.totals.solved++;
+        else
+            part.totals.exhausted++;
+    }
+
+    part.output += '\n';
+}// end static void solveSizedLine(Part &part, size_t i, Budget &budget,
+//                                 const BatchOptions &options)
+
+
+
+/******************************************************************************/
+/**
+
+ Splits a part into lines and solves every line with the solver of the
+ worker running it, keeping the output, the error messages and the totals
+ in the part until its chunk can be written out. Unless options.ordered is
+ set, each output line starts with the line number of its puzzle. With
+ options.countLimit set, the line is the number of solutions, counted up to
+ that limit, instead of a solution, and with options.grade set it is the
+ puzzle's grade (grader.h).
+
+ The LOCKSTEP engine gathers LANES puzzles at a time and solves them
+ together. Lines of 16, 256 or 625 squares are 4x4, 16x16 and 25x25 puzzles
+ and are solved by solveSizedLine().
+
+**/
+/******************************************************************************/
+
+
+
+static void solvePart(Part &part, Solver &solver,
+                      const BatchOptions &options)
+{
+    string error;
+    int arr[SIDE][SIDE];
+    Board board;
+    bool lockstep = solver.engine == LOCKSTEP && options.countLimit == 0 &&
+                    !options.grade && solver.cache == NULL;
+    LaneGroup group;
+
+    group.count = 0;
+
+    splitLines(part);
+
+    part.output.reserve(part.lineNumbers.size() * (CELLS + 1));
+
+    for (size_t i = 0; i < part.lineNumbers.size(); i++)
+    {
+        const char *text = part.data + part.starts[i];
+        size_t length = part.lengths[i];
+        int order = part.packed ? BOX_SIZE : puzzleOrder(text, length);
+        bool parsed;
+
+
+        /// The grader only knows the 9x9 techniques
+        if (options.grade && (order == 2 || order == 4 || order == 5))
+        {
+            part.errors += "line " + to_string(part.lineNumbers[i]) +
+                            ": only 9x9 puzzles can be graded\n";
+            part.totals.malformed++;
+            continue;
+        }
+
+        /// Other sizes go on their own, after the puzzles before them
+        if (order == 2 || order == 4 || order == 5)
+        {
+            if (group.count > 0)
+                solveGroup(group, part, solver.budget, options);
+
+            if (order == 2)
+                solveSizedLine<2>(part, i, solver.budget, options);
+            else if (order == 4)
+                solveSizedLine<4>(part, i, solver.budget, options);
+            else
+                solveSizedLine<5>(part, i, solver.budget, options);
+
+            continue;
+        }
+
+        if (part.packed)
+        {
+            parsed = unpackRecord(
+                reinterpret_cast<const unsigned char *>(text), arr);
+            error = "damaged record";
+        }
+        else
+            parsed = parsePuzzle(text, length, arr, error);
+
+        if (!parsed)
+        {
+            part.errors += (part.packed ? "record " : "line ") +
+                            to_string(part.lineNumbers[i]) + ": " + error +
+                            "\n";
+            part.totals.malformed++;
+            continue;
+        }
+
+        part.totals.puzzles++;
+
+
+        /// A puzzle whose numbers clash has no solution to look for
+        if (lockstep)
+        {
+            group.lineNumber[group.count] = part.lineNumbers[i];
+            group.valid[group.count] = initBoard(group.board[group.count],
+                                                 arr);
+
+            if (++group.count == LANES)
+                solveGroup(group, part, solver.budget, options);
+        }
+        else if (options.grade)
+        {
+            Grade grade;
+            SolveStatus status;
+            char solution[CELLS];
+
+            if (!options.ordered)
+                part.output += to_string(part.lineNumbers[i]) + ' ';
+
+            startBudget(solver.budget);
+
+            status = gradePuzzle(arr, grade, board, solver.budget);
+
+            if (status == SOLVE_SOLVED)
+            {
+                writeGrade(grade, part.output);
+                part.totals.solved++;
+
+                if (grade.hardest == GUESS)
+                    part.totals.searched++;
+            }
+            else if (status == SOLVE_EXHAUSTED)
+            {
+                writeBoard(board, solution);
+                part.output += string(statusName(status)) + ' ';
+                part.output.append(solution, CELLS);
+                part.totals.exhausted++;
+            }
+            else
+            {
+                part.output += "no solution";
+                part.totals.unsolvable++;
+            }
+
+            part.output += '\n';
+        }
+        else if (options.countLimit > 0)
+        {
+            int count = 0;
+
+            if (!options.ordered)
+                part.output += to_string(part.lineNumbers[i]) + ' ';
+
+            startBudget(solver.budget);
+
+            if (initBoard(board, arr))
+                count = countSolutions(board, options.countLimit,
+                                       solver.budget);
+
+            if (solver.budget.exhausted)
+                part.output += string(statusName(SOLVE_EXHAUSTED)) + ' ';
+
+            part.output += to_string(count) + '\n';
+
+            if (solver.budget.exhausted)
+                part.totals.exhausted++;
+            else if (count > 0)
+                part.totals.solved++;
+            else
+                part.totals.unsolvable++;
+        }
+        else
+        {
+            bool hit;
+            SolveStatus status = solveArray(solver, arr, board, hit);
+
+            if (solver.cache != NULL)
+            {
+                if (hit)
+                    part.totals.cacheHits++;
+                else
+                    part.totals.cacheMisses++;
+            }
+
+            writeResult(part, part.lineNumbers[i], status, board, options);
+        }
+
+    }// end for (size_t i = 0; i < part.lineNumbers.size(); i++)
+
+    if (group.count > 0)
+        solveGroup(group, part, solver.budget, options);
+
+}// end static void solvePart(Part &part, Solver &solver,
+//                             const BatchOptions &options)
+
+
+
+/******************************************************************************/
+/**
+
+ Reads puzzles from input until it runs out, writing a line to out for
+ each. Empty lines are skipped quietly. Returns how many lines of each kind
+ there were.
+
+ The input is handed out in chunks of whole lines (readChunk()), each cut
+ into parts of a few dozen lines (cutParts()), and the parts are solved on
+ a work stealing pool, each worker with its own Solver. A chunk is finished
+ when all of its parts are. Finished chunks wait in a reorder buffer until
+ every chunk before them has been written, so the output comes out in the
+ same order as the input. With options.ordered false, chunks are written as
+ soon as they finish and each line is numbered instead. No more than a few
+ chunks per worker are read ahead, so memory use does not grow with the size
+ of the input.
+
+**/
+/******************************************************************************/
+
+
+
+static BatchTotals runInput(BatchInput &input, ostream &out,
+                            const BatchOptions &options)
+{
+    BatchTotals totals = { 0, 0, 0, 0, 0, 0, 0, 0, false };
+    int threads = options.threads > 0 ? options.threads : defaultThreads();
+    long submitted = 0, written = 0;
+    vector<Solver *> solvers;
+    vector<Chunk *> finished;
+    map<long, Chunk *> reorder;
+    mutex doneLock;
+    condition_variable doneWake;
+    WorkPool pool;
+    SolutionCache cache;
+    Chunk *chunk;
+
+    initCache(cache, options.cacheSize);
+
+    for (int i = 0; i < threads; i++)
+    {
+        solvers.push_back(new Solver);
+        initSolver(*solvers[i], options.engine);
+
+        solvers[i]->budget = options.limits;
+
+        if (options.cacheSize > 0)
+            solvers[i]->cache = &cache;
+    }
+
+    startPool(pool, threads);
+
+
+    /// Writes out a finished chunk, part by part, and adds its totals in
+    auto write = [&](Chunk *done)
+    {
+        for (size_t i = 0; i < done->parts.size(); i++)
+        {
+            const Part &part = done->parts[i];
+
+            out.write(part.output.data(), part.output.size());
+            cerr << part.errors;
+
+            totals.puzzles += part.totals.puzzles;
+            totals.solved += part.totals.solved;
+            totals.unsolvable += part.totals.unsolvable;
+            totals.malformed += part.totals.malformed;
+            totals.searched += part.totals.searched;
+            totals.cacheHits += part.totals.cacheHits;
+            totals.cacheMisses += part.totals.cacheMisses;
+            totals.exhausted += part.totals.exhausted;
+        }
+
+        written++;
+        delete done;
+    };
+
+
+    /// Collects the chunks the workers have finished, waiting for one if
+    /// wait is set, and writes out every one that can be
+    auto drain = [&](bool wait)
+    {
+        vector<Chunk *> ready;
+
+        {
+            unique_lock<mutex> guard(doneLock);
+
+            if (wait)
+                doneWake.wait(guard, [&finished] { return !finished.empty(); });
+
+            ready.swap(finished);
+        }
+
+        for (size_t i = 0; i < ready.size(); i++)
+        {
+            if (options.ordered)
+                reorder[ready[i]->index] = ready[i];
+            else
+                write(ready[i]);
+        }
+
+        while (!reorder.empty() && reorder.begin()->first == written)
+        {
+            Chunk *next = reorder.begin()->second;
+
+            reorder.erase(reorder.begin());
+            write(next);
+        }
+    };
+
+
+    /// Hands each part of a chunk to the pool; whichever worker solves the
+    /// last part marks the chunk finished
+    auto send = [&](Chunk *full)
+    {
+        cutParts(*full);
+
+        if (full->parts.empty())
+        {
+            lock_guard<mutex> guard(doneLock);
+            finished.push_back(full);
+        }
+
+        for (size_t i = 0; i < full->parts.size(); i++)
+        {
+            Part *part = &full->parts[i];
+
+            submit(pool, [full, part, &solvers, &options, &doneLock,
+                          &doneWake, &finished](int worker)
+            {
+                solvePart(*part, *solvers[worker], options);
+
+                lock_guard<mutex> guard(doneLock);
+
+                if (--full->partsLeft == 0)
+                {
+                    finished.push_back(full);
+                    doneWake.notify_one();
+                }
+            });
+        }
+
+        submitted++;
+    };
+
+
+    chunk = newChunk(submitted);
+
+    while (readChunk(input, *chunk))
+    {
+        send(chunk);
+        chunk = newChunk(submitted);
+
+        drain(false);
+
+        while (submitted - written >= CHUNKS_PER_WORKER * threads)
+            drain(true);
+    }
+
+    delete chunk;
+
+    while (written < submitted)
+        drain(true);
+
+    out.flush();
+
+    stopPool(pool);
+
+    for (int i = 0; i < threads; i++)
+        delete solvers[i];
+
+    return totals;
+}// end static BatchTotals runInput(BatchInput &input, ostream &out,
+//                                  const BatchOptions &options)
+
+
+
+/******************************************************************************/
+/**
+
+ Runs a batch from a stream, such as standard input or a pipe, read a chunk
+ at a time (see runInput()).
+
+**/
+/******************************************************************************/
+
+
+
+BatchTotals runBatch(istream &in, ostream &out, const BatchOptions &options)
+{
+    BatchInput input = { &in, NULL, 0, 0, false, string(), 0 };
+
+    return runInput(input, out, options);
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Runs a batch straight out of a mapped file (corpus.h), of text or packed
+ (packed.h). The chunks point into the mapping, so no puzzle is copied on
+ its way to the solver. A packed file whose header cannot be read, or
+ whose length does not match it, is reported on standard error and nothing
+ is solved; the totals come back with unreadable set.
+
+**/
+/******************************************************************************/
+
+
+
+BatchTotals runBatch(const MappedFile &file, ostream &out,
+                     const BatchOptions &options)
+{
+    BatchInput input = { NULL, file.data, file.size, 0, false, string(), 0 };
+    BatchTotals none = { 0, 0, 0, 0, 0, 0, 0, 0, true };
+    PackedHeader header;
+    string error;
+
+    if (isPacked(file.data, file.size))
+    {
+        if (!readPackedHeader(file.data, file.size, header, error))
+        {
+            cerr << error << endl;
+            return none;
+        }
+
+        input.data = reinterpret_cast<const char *>(packedRecord(file.data, 0));
+        input.size = size_t(header.count) * PACKED_RECORD;
+        input.packed = true;
+    }
+
+    return runInput(input, out, options);
+}
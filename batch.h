@@ -0,0 +1,103 @@
+/**
+  Name: batch.h
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Batch mode. Reads puzzles, one per line (see corpus.h),
+  straight out of a mapped file, or from a stream such as standard input, and
+  writes one line per puzzle: the solution, or "no solution". A line that is
+  not a puzzle is reported on standard error with its line number and
+  skipped, and the run carries on. A mapped file can also be packed
+  (packed.h), and is then read without any parsing.
+
+  Puzzles are solved on every core at once (pool.h). The solutions still come
+  out in the same order as the puzzles, unless ordered is turned off, in which
+  case they come out as they are found, each starting with the line number of
+  its puzzle.
+
+  With a count limit the line for each puzzle is its number of solutions
+  instead, counted with countSolutions() up to the limit. A limit of 2 tells
+  puzzles with no solution (0), a unique solution (1) and several (2) apart.
+
+  With grade set the line for each puzzle is its difficulty instead, as
+  written by writeGrade() (grader.h).
+
+  With a cache size set, each 9x9 puzzle is first put in canonical form
+  (canonical.h) and looked up in a cache of solutions (cache.h), and only
+  solved on a miss, so copies of a puzzle that are only relabelled or
+  rearranged are solved once. Putting a puzzle in canonical form costs about
+  as much as solving a few easy ones, so this pays off on collections with
+  many repeats or hard puzzles. A puzzle with more than one solution may get
+  a different one of them than it would without the cache. The cache is not
+  used for counting, grading or the LOCKSTEP engine.
+
+  Each puzzle can be held to a budget (budget.h) of nodes, backtracks and
+  time. A puzzle that runs out gets "budget exhausted" and the board as far
+  as logic got, or the solutions counted so far, and the run carries on.
+  With the LOCKSTEP engine the budget holds for the search of each puzzle
+  the lockstep logic could not finish.
+
+  A line of 16, 256 or 625 squares is taken for a 4x4, 16x16 or 25x25 puzzle
+  (sized.h) and always solved with depth first search. Only 9x9 puzzles can
+  be graded.
+*/
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <iostream>
+#include <string>
+
+#include "board.h"
+#include "budget.h"
+#include "cache.h"
+#include "corpus.h"
+#include "dlx.h"
+
+enum Engine { DEPTH_FIRST, DANCING_LINKS, LOCKSTEP };
+
+/// Everything one solving thread needs, allocated once and reused for every
+/// puzzle
+struct Solver
+{
+    Engine engine;
+    Dlx dlx;                        // only linked for DANCING_LINKS
+    SolutionCache *cache;           // shared by every solver, NULL for none
+    Budget budget;                  // started afresh for every puzzle
+};
+
+struct BatchTotals
+{
+    long puzzles;                   // lines that were puzzles
+    long solved;
+    long unsolvable;
+    long malformed;                 // lines skipped
+    long searched;                  // graded puzzles logic could not solve
+    long cacheHits;                 // puzzles whose solution was cached
+    long cacheMisses;
+    long exhausted;                 // puzzles that ran out of budget
+    bool unreadable;                // the input could not be read at all
+};
+
+struct BatchOptions
+{
+    Engine engine;
+    int threads;                    // 0 for one per core
+    bool ordered;                   // false to number lines instead
+    int countLimit;                 // count solutions up to this, 0 to solve
+    bool grade;                     // grade each puzzle instead
+    size_t cacheSize;               // solutions cached, 0 for no cache
+    Budget limits;                  // for each puzzle, see budget.h
+};
+
+bool parseEngine(const std::string &name, Engine &engine);
+void initSolver(Solver &solver, Engine engine);
+SolveStatus solveBoard(Solver &solver, Board &board);
+SolveStatus solveArray(Solver &solver, int arr[][SIDE], Board &board,
+                       bool &hit);
+BatchTotals runBatch(std::istream &in, std::ostream &out,
+                     const BatchOptions &options);
+BatchTotals runBatch(const MappedFile &file, std::ostream &out,
+                     const BatchOptions &options);
+
+#endif // BATCH_H
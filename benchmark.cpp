@@ -0,0 +1,378 @@
+/**
+  Name: benchmark.cpp
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Benchmark for the different ways of solving a puzzle. Loads a
+  corpus, solves every puzzle with each engine and reports how many were
+  solved, puzzles per second and the min, median, 99th percentile and max
+  time per puzzle.
+
+  Engines:
+    solve   logic only, solve() from logic.cpp
+    brute   solve(), then bruteForce() if logic is not enough, like main()
+    dfs     depth first search (search.h)
+    dlx     Dancing Links (dlx.h)
+    simd    16 puzzles at a time with vector instructions (simd.h); each
+            puzzle is timed as its share of the 16
+
+  bruteForce() never returns on a puzzle with no
+  solution, so it is only given puzzles that have one. Even then it starts
+  over on every dead end and can run for hours on a puzzle with few numbers,
+  so it is left out unless asked for with -e.
+
+  The corpus is read from a file with -f, one puzzle per line (corpus.h), or
+  generated with -n puzzles from seed -s (generator.h), so runs can be
+  repeated anywhere. Brute force guesses from the same seed. -w writes the
+  generated corpus to a file. -e picks the engines, comma separated.
+
+  Compile with:
+
+  g++ -O2 -pthread -o benchmark benchmark.cpp logic.cpp board.cpp search.cpp \
+      dlx.cpp corpus.cpp generator.cpp pool.cpp trace.cpp simd.cpp \
+      counters.cpp budget.cpp
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "board.h"
+#include "corpus.h"
+#include "dlx.h"
+#include "generator.h"
+#include "logic.h"
+#include "search.h"
+#include "simd.h"
+
+using namespace std;
+
+struct Puzzle
+{
+    int arr[SIDE][SIDE];
+    bool solvable;
+};
+
+
+
+/******************************************************************************/
+/**
+
+ Reads every puzzle in fileName, or standard input for "-", into corpus.
+ Lines that are not puzzles are reported and skipped. Returns false if the
+ file cannot be opened.
+
+**/
+/******************************************************************************/
+
+
+
+bool loadCorpus(const string &fileName, vector<Puzzle> &corpus)
+{
+    ifstream file;
+    istream *in = &cin;
+    string line, error;
+    long lineNumber = 0;
+    Board board;
+
+    if (fileName != "-")
+    {
+        file.open(fileName.c_str());
+
+        if (!file.is_open())
+            return false;
+
+        in = &file;
+    }
+
+    while (getline(*in, line))
+    {
+        Puzzle puzzle;
+
+        lineNumber++;
+
+        if (line.find_first_not_of(" \t\r") == string::npos)
+            continue;
+
+        if (!parsePuzzle(line.data(), line.size(), puzzle.arr, error))
+        {
+            cerr << "line " << lineNumber << ": " << error << endl;
+            continue;
+        }
+
+        puzzle.solvable = initBoard(board, puzzle.arr) &&
+                          countSolutions(board, 1) == 1;
+
+        corpus.push_back(puzzle);
+    }
+
+    return true;
+}// end bool loadCorpus(const string &fileName, vector<Puzzle> &corpus)
+
+
+
+/******************************************************************************/
+/**
+
+ Generates count puzzles from seed into corpus.
+
+**/
+/******************************************************************************/
+
+
+
+void generateCorpus(int count, unsigned long long seed, vector<Puzzle> &corpus)
+{
+    Random random;
+    Board board;
+
+    seedRandom(random, seed);
+
+    for (int i = 0; i < count; i++)
+    {
+        Puzzle puzzle;
+
+        generatePuzzle(random, board);
+
+        for (int cell = 0; cell < CELLS; cell++)
+            puzzle.arr[rowOf(cell)][colOf(cell)] = board.value[cell];
+
+        puzzle.solvable = true;
+
+        corpus.push_back(puzzle);
+    }
+}// end void generateCorpus(int count, unsigned long long seed,
+//                         vector<Puzzle> &corpus)
+
+
+
+/******************************************************************************/
+/**
+
+ Solves one puzzle with engine, brute force guessing from seed. Returns
+ true if it was solved.
+
+**/
+/******************************************************************************/
+
+
+
+bool runEngine(const string &engine, const Puzzle &puzzle, Dlx &dlx,
+               unsigned long long seed)
+{
+    int arr[SIDE][SIDE], leftToSolve = 0;
+
+    for (int j = 0; j < SIDE; j++)
+        for (int k = 0; k < SIDE; k++)
+        {
+            arr[j][k] = puzzle.arr[j][k];
+
+            if (arr[j][k] == 0)
+                leftToSolve++;
+        }
+
+    if (engine == "solve")
+        return solve(arr, leftToSolve);
+    else if (engine == "brute")
+        return solve(arr, leftToSolve) || bruteForce(arr, seed);
+    else if (engine == "dfs")
+        return depthFirst(arr);
+    else
+        return dlxSolve(dlx, arr);
+}// end bool runEngine(const string &engine, const Puzzle &puzzle, Dlx &dlx,
+//                     unsigned long long seed)
+
+
+
+/******************************************************************************/
+/**
+
+ Times engine on every puzzle of the corpus it can be given and prints one
+ line of results. Times are in microseconds. Puzzle i is brute forced from
+ seed + i.
+
+**/
+/******************************************************************************/
+
+
+
+void benchmark(const string &engine, const vector<Puzzle> &corpus, Dlx &dlx,
+               unsigned long long seed)
+{
+    typedef chrono::steady_clock Clock;
+
+    vector<double> times;
+    double total = 0;
+    long solved = 0, skipped = 0;
+
+    times.reserve(corpus.size());
+
+    for (size_t i = 0; engine == "simd" && i < corpus.size(); i += LANES)
+    {
+        Board boards[LANES];
+        bool laneSolved[LANES];
+        int count = 0;
+
+        for (size_t j = i; j < corpus.size() && j < i + LANES; j++)
+        {
+            int arr[SIDE][SIDE];
+
+            memcpy(arr, corpus[j].arr, sizeof(arr));
+
+            if (initBoard(boards[count], arr))
+                count++;
+            else
+                skipped++;
+        }
+
+        Clock::time_point start = Clock::now();
+
+        solveLanes(boards, count, laneSolved);
+
+        Clock::time_point stop = Clock::now();
+
+        for (int l = 0; l < count; l++)
+        {
+            if (laneSolved[l])
+                solved++;
+
+            times.push_back(chrono::duration<double, micro>(stop - start)
+                            .count() / count);
+            total += times.back();
+        }
+    }
+
+    for (size_t i = 0; engine != "simd" && i < corpus.size(); i++)
+    {
+        if (engine == "brute" && !corpus[i].solvable)
+        {
+            skipped++;
+            continue;
+        }
+
+        Clock::time_point start = Clock::now();
+
+        if (runEngine(engine, corpus[i], dlx, seed + i))
+            solved++;
+
+        Clock::time_point stop = Clock::now();
+
+        times.push_back(chrono::duration<double, micro>(stop - start).count());
+        total += times.back();
+    }
+
+    sort(times.begin(), times.end());
+
+    cout << left << setw(8) << engine << right << setw(9) << times.size()
+         << setw(9) << solved << fixed << setprecision(0) << setw(12)
+         << (total > 0 ? times.size() / (total / 1e6) : 0) << setprecision(1);
+
+    if (times.empty())
+        cout << setw(10) << "-" << setw(10) << "-" << setw(10) << "-"
+             << setw(10) << "-";
+    else
+        cout << setw(10) << times.front() << setw(10) << times[times.size() / 2]
+             << setw(10) << times[(times.size() * 99 + 99) / 100 - 1]
+             << setw(10) << times.back();
+
+    if (skipped > 0)
+        cout << "  (" << skipped << " with no solution skipped)";
+
+    if (engine == "simd")
+        cout << "  (" << lockstepTarget() << ")";
+
+    cout << endl;
+}// end void benchmark(const string &engine, const vector<Puzzle> &corpus,
+//                    Dlx &dlx, unsigned long long seed)
+
+
+
+/******************************************************************************/
+
+int main(int argc, char *argv[])
+{
+    string fileName, writeName, engines = "solve,dfs,dlx,simd", engine;
+    int count = 1000;
+    unsigned long long seed = 1;
+    vector<Puzzle> corpus;
+    static Dlx dlx;
+
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+
+        if (arg == "-f" && i + 1 < argc)
+            fileName = argv[++i];
+        else if (arg == "-n" && i + 1 < argc)
+            count = atoi(argv[++i]);
+        else if (arg == "-s" && i + 1 < argc)
+            seed = strtoull(argv[++i], NULL, 10);
+        else if (arg == "-e" && i + 1 < argc)
+            engines = argv[++i];
+        else if (arg == "-w" && i + 1 < argc)
+            writeName = argv[++i];
+        else
+        {
+            cerr << "usage: " << argv[0] << " [-f file|-] [-n count] [-s seed]"
+                 << " [-e solve,brute,dfs,dlx,simd] [-w file]" << endl;
+            return 1;
+        }
+    }
+
+    if (!fileName.empty())
+    {
+        if (!loadCorpus(fileName, corpus))
+        {
+            cerr << "ERROR: unable to open " << fileName << endl;
+            return 1;
+        }
+    }
+    else
+        generateCorpus(count, seed, corpus);
+
+
+    /// Saves the generated corpus so other tools can use the same puzzles
+    if (!writeName.empty())
+    {
+        ofstream out(writeName.c_str());
+        Board board;
+        char line[CELLS];
+
+        for (size_t i = 0; i < corpus.size(); i++)
+        {
+            initBoard(board, corpus[i].arr);
+            writeBoard(board, line);
+            out.write(line, CELLS) << '\n';
+        }
+    }
+
+    initDlx(dlx);
+
+    cout << left << setw(8) << "engine" << right << setw(9) << "puzzles"
+         << setw(9) << "solved" << setw(12) << "puzzles/s" << setw(10)
+         << "min us" << setw(10) << "median" << setw(10) << "p99"
+         << setw(10) << "max" << endl;
+
+    stringstream list(engines);
+
+    while (getline(list, engine, ','))
+    {
+        if (engine != "solve" && engine != "brute" && engine != "dfs" &&
+            engine != "dlx" && engine != "simd")
+        {
+            cerr << "unknown engine: " << engine << endl;
+            return 1;
+        }
+
+        benchmark(engine, corpus, dlx, seed);
+    }
+
+    return 0;
+}
@@ -0,0 +1,309 @@
+/**
+  Name: board.cpp
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Builds the persistent solver state from a puzzle and keeps it
+  up to date as numbers are placed. See board.h.
+*/
+
+#include "board.h"
+
+/// Every square's row, column and 3x3 grid, the square itself included
+struct PeerCells
+{
+    Bitboard cells[CELLS];
+
+    PeerCells()
+    {
+        for (int cell = 0; cell < CELLS; cell++)
+        {
+            cells[cell].lo = 0;
+            cells[cell].hi = 0;
+
+            addCell(cells[cell], cell);
+
+            for (int i = 0; i < PEERS; i++)
+                addCell(cells[cell], peerCell(cell, i));
+        }
+    }
+};
+
+static const PeerCells peers;
+
+
+
+/******************************************************************************/
+/**
+
+ Fills the board from the array, zeros being empty squares. The row, column
+ and 3x3 grid masks are filled from the numbers already on the board, then
+ every empty square gets the numbers not used by its row, column or 3x3 grid
+ as its potential numbers, and every number the bitboard of the squares it
+ can go on. Returns false if the same number appears twice in
+ a row, column or 3x3 grid.
+
+**/
+/******************************************************************************/
+
+
+
+bool initBoard(Board &board, int arr[][SIDE])
+{
+    bool valid = true;
+
+    board.left = 0;
+
+    for (int i = 0; i < SIDE; i++)
+    {
+        board.rowUsed[i] = 0;
+        board.colUsed[i] = 0;
+        board.boxUsed[i] = 0;
+    }
+
+
+    /// Marks every number on the board as used in its row, column and 3x3
+    /// grid
+    for (int cell = 0; cell < CELLS; cell++)
+    {
+        int digit = arr[rowOf(cell)][colOf(cell)];
+
+        board.value[cell] = digit;
+
+        if (digit == 0)
+        {
+            board.left++;
+            continue;
+        }
+
+        unsigned short bit = digitBit(digit);
+
+        if ((board.rowUsed[rowOf(cell)] | board.colUsed[colOf(cell)] |
+             board.boxUsed[boxOf(cell)]) & bit)
+        {
+            valid = false;
+        }
+
+        board.rowUsed[rowOf(cell)] |= bit;
+        board.colUsed[colOf(cell)] |= bit;
+        board.boxUsed[boxOf(cell)] |= bit;
+
+    }// end for (int cell = 0; cell < CELLS; cell++)
+
+
+    /// What is left over is what each empty square can still be
+    for (int cell = 0; cell < CELLS; cell++)
+    {
+        if (board.value[cell] == 0)
+            board.cand[cell] = ALL_DIGITS &
+                               ~(board.rowUsed[rowOf(cell)] |
+                                 board.colUsed[colOf(cell)] |
+                                 board.boxUsed[boxOf(cell)]);
+        else
+            board.cand[cell] = 0;
+    }
+
+    for (int d = 0; d < SIDE; d++)
+    {
+        board.digitCells[d].lo = 0;
+        board.digitCells[d].hi = 0;
+    }
+
+    for (int cell = 0; cell < CELLS; cell++)
+        for (int d = 1; d <= SIDE; d++)
+            if (board.cand[cell] & digitBit(d))
+                addCell(board.digitCells[d - 1], cell);
+
+    return valid;
+}// end bool initBoard(Board &board, int arr[][SIDE])
+
+
+
+/******************************************************************************/
+/**
+
+ Places digit on an empty square and removes it from the potential numbers
+ of every square sharing its row, column or 3x3 grid, and from the
+ bitboards. Returns false, without changing anything, if digit is not a
+ potential number of the square.
+
+**/
+/******************************************************************************/
+
+
+
+bool placeDigit(Board &board, int cell, int digit)
+{
+    unsigned short bit = digitBit(digit), clear = ~bit;
+    int row = rowOf(cell), col = colOf(cell), box = boxOf(cell);
+    Bitboard &cells = board.digitCells[digit - 1];
+
+    if (!(board.cand[cell] & bit))
+        return false;
+
+
+    /// The square is gone from the bitboard of every number it could have
+    /// held, and the number from every square that shares a unit with it
+    for (unsigned short other = board.cand[cell] & clear; other != 0;
+         other &= other - 1)
+        removeCell(board.digitCells[firstDigit(other) - 1], cell);
+
+    cells.lo &= ~peers.cells[cell].lo;
+    cells.hi &= ~peers.cells[cell].hi;
+
+    board.value[cell] = digit;
+    board.cand[cell] = 0;
+    board.left--;
+
+    board.rowUsed[row] |= bit;
+    board.colUsed[col] |= bit;
+    board.boxUsed[box] |= bit;
+
+
+    /// Eliminates the number from the row, column and 3x3 grid
+    for (int i = 0; i < PEERS; i++)
+        board.cand[peerCell(cell, i)] &= clear;
+
+    return true;
+}// end bool placeDigit(Board &board, int cell, int digit)
+
+
+
+/******************************************************************************/
+/**
+
+ Starts a trail with nothing on it.
+
+**/
+/******************************************************************************/
+
+
+
+void initTrail(Trail &trail)
+{
+    trail.size = 0;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ placeDigit(), logged on the trail: the square's potential numbers and which
+ of its peers lose digit, read off digit's bitboard, are kept so undoTrail()
+ can put them back. Returns
+ false, logging nothing, if digit is not a potential number of the square.
+
+**/
+/******************************************************************************/
+
+
+
+bool placeDigit(Board &board, Trail &trail, int cell, int digit)
+{
+    TrailEntry &entry = trail.entry[trail.size];
+    unsigned short bit = digitBit(digit);
+
+    if (!(board.cand[cell] & bit))
+        return false;
+
+    entry.cell = (unsigned char)cell;
+    entry.digit = (unsigned char)digit;
+    entry.cand = board.cand[cell];
+    entry.peers.lo = board.digitCells[digit - 1].lo & peers.cells[cell].lo;
+    entry.peers.hi = board.digitCells[digit - 1].hi & peers.cells[cell].hi;
+    removeCell(entry.peers, cell);
+
+    trail.size++;
+
+    return placeDigit(board, cell, digit);
+}// end bool placeDigit(Board &board, Trail &trail, int cell, int digit)
+
+
+
+/******************************************************************************/
+/**
+
+ removeDigit(), logged on the trail. Returns false, logging nothing, if
+ digit is not a potential number of the square.
+
+**/
+/******************************************************************************/
+
+
+
+bool removeDigit(Board &board, Trail &trail, int cell, int digit)
+{
+    TrailEntry &entry = trail.entry[trail.size];
+
+    if (!(board.cand[cell] & digitBit(digit)))
+        return false;
+
+    entry.cell = (unsigned char)cell;
+    entry.digit = (unsigned char)digit;
+    entry.cand = 0;
+
+    trail.size++;
+
+    removeDigit(board, cell, digit);
+
+    return true;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Takes back every change on the trail after mark, newest first, leaving the
+ board as it was when trail.size was mark.
+
+**/
+/******************************************************************************/
+
+
+
+void undoTrail(Board &board, Trail &trail, int mark)
+{
+    while (trail.size > mark)
+    {
+        const TrailEntry &entry = trail.entry[--trail.size];
+        int cell = entry.cell, digit = entry.digit;
+        unsigned short bit = digitBit(digit);
+
+        if (entry.cand == 0)
+        {
+            board.cand[cell] |= bit;
+            addCell(board.digitCells[digit - 1], cell);
+            continue;
+        }
+
+
+        /// The square goes back on the bitboard of every number it could
+        /// hold, and the number back on every peer that lost it
+        board.value[cell] = 0;
+        board.cand[cell] = entry.cand;
+        board.left++;
+
+        board.rowUsed[rowOf(cell)] &= ~bit;
+        board.colUsed[colOf(cell)] &= ~bit;
+        board.boxUsed[boxOf(cell)] &= ~bit;
+
+        for (unsigned short other = entry.cand; other != 0;
+             other &= other - 1)
+            addCell(board.digitCells[firstDigit(other) - 1], cell);
+
+        for (unsigned long long lost = entry.peers.lo; lost != 0;
+             lost &= lost - 1)
+            board.cand[lowestBit(lost)] |= bit;
+
+        for (unsigned long long lost = entry.peers.hi; lost != 0;
+             lost &= lost - 1)
+            board.cand[64 + lowestBit(lost)] |= bit;
+
+        board.digitCells[digit - 1].lo |= entry.peers.lo;
+        board.digitCells[digit - 1].hi |= entry.peers.hi;
+
+    }// end while (trail.size > mark)
+
+}// end void undoTrail(Board &board, Trail &trail, int mark)
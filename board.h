@@ -0,0 +1,211 @@
+/**
+  Name: board.h
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Persistent solver state. Instead of rescanning the row, column
+  and 3x3 grid of a square every time its potential numbers are needed, the
+  board keeps a 9 bit mask of potential numbers for every square and a mask of
+  the numbers already used in every row, column and 3x3 grid. Placing a number
+  only has to clear one bit from the squares that share a row, column or 3x3
+  grid with it.
+
+  Bit d - 1 of a mask stands for the number d, so the mask 0x1FF means every
+  number from 1 to 9 is still possible.
+
+  The same potential numbers are also kept the other way round: for every
+  number, an 81 bit bitboard of the squares it can still go on. Techniques
+  that look at one number across the whole board, like the fish in logic.h,
+  read a row of it as a 9 bit mask of columns.
+
+  Changes can also be made through a trail, which logs each one so it can be
+  taken back: undoTrail() reverts everything since a mark in time
+  proportional to what changed, without copying the board. That is how the
+  search (search.h) backtracks, and how a single move can be retracted.
+*/
+
+#ifndef BOARD_H
+#define BOARD_H
+
+#include "geometry.h"
+
+const int BOX_SIZE = 3;                             // width of a 3x3 grid
+const int SIDE = Geometry<BOX_SIZE>::SIDE;          // squares in a row
+const int CELLS = Geometry<BOX_SIZE>::CELLS;        // squares on the board
+const unsigned short ALL_DIGITS = (1 << SIDE) - 1;
+
+/// One bit per square: squares 0 - 63 in lo, 64 - 80 in hi
+struct Bitboard
+{
+    unsigned long long lo, hi;
+};
+
+struct Board
+{
+    int value[CELLS];                   // 0 for an empty square
+    unsigned short cand[CELLS];         // potential numbers, 0 once filled
+    unsigned short rowUsed[SIDE];       // numbers already placed in each row
+    unsigned short colUsed[SIDE];       // numbers already placed in each column
+    unsigned short boxUsed[SIDE];       // numbers already placed in each grid
+    Bitboard digitCells[SIDE];          // squares each number can still go on
+    int left;                           // empty squares remaining
+};
+
+/// One change made through a trail, enough to take it back
+struct TrailEntry
+{
+    unsigned char cell;
+    unsigned char digit;
+    unsigned short cand;                // the square's potential numbers
+                                        // before a placement, 0 for an
+                                        // elimination
+    Bitboard peers;                     // squares that lost digit to the
+                                        // placement
+};
+
+/// As many changes as can be on a trail at once: every square placed and
+/// every potential number eliminated
+const int TRAIL_SIZE = CELLS + CELLS * SIDE;
+
+struct Trail
+{
+    TrailEntry entry[TRAIL_SIZE];
+    int size;                           // also the mark for what comes next
+};
+
+
+
+/// Squares are numbered 0 - 80 left to right, top to bottom, and 3x3 grids
+/// the same way. Units 0 - 8 are the rows, 9 - 17 the columns and 18 - 26
+/// the 3x3 grids.
+const int UNITS = Geometry<BOX_SIZE>::UNITS;
+
+/// Squares sharing a row, column or 3x3 grid with a square
+const int PEERS = Geometry<BOX_SIZE>::PEERS;
+
+/// Where every square sits, worked out once by the compiler so that finding
+/// a square's 3x3 grid or peers is a table lookup (geometry.h)
+static constexpr const Tables<BOX_SIZE> &LAYOUT = Lookup<BOX_SIZE>::tables;
+
+
+
+inline int rowOf(int cell) { return LAYOUT.row[cell]; }
+inline int colOf(int cell) { return LAYOUT.col[cell]; }
+inline int boxOf(int cell) { return LAYOUT.box[cell]; }
+
+/// The i-th square (0 - 8) of a unit
+inline int unitCell(int unit, int i) { return LAYOUT.unit[unit][i]; }
+
+/// The i-th peer (0 - 19) of a square
+inline int peerCell(int cell, int i) { return LAYOUT.peer[cell][i]; }
+
+inline unsigned short digitBit(int digit) { return 1 << (digit - 1); }
+
+
+
+/// Number of potential numbers in a mask
+inline int countDigits(unsigned short mask)
+{
+#if defined(__GNUC__)
+    return __builtin_popcount(mask);
+#else
+    int count = 0;
+
+    for (; mask; mask &= mask - 1)
+        count++;
+
+    return count;
+#endif
+}
+
+
+
+/// Lowest number in a mask, 0 if the mask is empty
+inline int firstDigit(unsigned short mask)
+{
+#if defined(__GNUC__)
+    return mask ? __builtin_ctz(mask) + 1 : 0;
+#else
+    for (int d = 1; d <= SIDE; d++)
+        if (mask & digitBit(d))
+            return d;
+
+    return 0;
+#endif
+}
+
+
+
+inline bool hasCell(const Bitboard &cells, int cell)
+{
+    return cell < 64 ? (cells.lo >> cell) & 1 : (cells.hi >> (cell - 64)) & 1;
+}
+
+inline void addCell(Bitboard &cells, int cell)
+{
+    if (cell < 64)
+        cells.lo |= 1ULL << cell;
+    else
+        cells.hi |= 1ULL << (cell - 64);
+}
+
+inline void removeCell(Bitboard &cells, int cell)
+{
+    if (cell < 64)
+        cells.lo &= ~(1ULL << cell);
+    else
+        cells.hi &= ~(1ULL << (cell - 64));
+}
+
+
+
+/// Lowest set bit of a word of a bitboard, which must not be 0
+inline int lowestBit(unsigned long long bits)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(bits);
+#else
+    int bit = 0;
+
+    for (; !(bits & 1); bits >>= 1)
+        bit++;
+
+    return bit;
+#endif
+}
+
+
+
+/// The squares of a row in a bitboard as a 9 bit mask, bit n for column n
+inline unsigned short rowCells(const Bitboard &cells, int row)
+{
+    int start = row * SIDE;
+
+    if (start + SIDE <= 64)
+        return (cells.lo >> start) & ALL_DIGITS;
+    else if (start >= 64)
+        return (cells.hi >> (start - 64)) & ALL_DIGITS;
+
+    return ((cells.lo >> start) | (cells.hi << (64 - start))) & ALL_DIGITS;
+}
+
+
+
+/// Takes digit off the potential numbers of a square
+inline void removeDigit(Board &board, int cell, int digit)
+{
+    board.cand[cell] &= ~digitBit(digit);
+    removeCell(board.digitCells[digit - 1], cell);
+}
+
+
+
+bool initBoard(Board &board, int arr[][SIDE]);
+bool placeDigit(Board &board, int cell, int digit);
+
+void initTrail(Trail &trail);
+bool placeDigit(Board &board, Trail &trail, int cell, int digit);
+bool removeDigit(Board &board, Trail &trail, int cell, int digit);
+void undoTrail(Board &board, Trail &trail, int mark);
+
+#endif // BOARD_H
@@ -0,0 +1,95 @@
+/**
+  Name: budget.cpp
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Search budgets. See budget.h.
+*/
+
+#include "budget.h"
+
+using namespace std;
+
+
+
+/******************************************************************************/
+/**
+
+ Sets up a budget with no limits and no cancel flag.
+
+**/
+/******************************************************************************/
+
+
+
+void initBudget(Budget &budget)
+{
+    budget.maxNodes = 0;
+    budget.maxRestarts = 0;
+    budget.timeLimit = 0;
+    budget.cancel = NULL;
+
+    startBudget(budget);
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Starts spending the budget from nothing, with the time limit counted from
+ now. Called before each puzzle, so the same limits do for any number of
+ them.
+
+**/
+/******************************************************************************/
+
+
+
+void startBudget(Budget &budget)
+{
+    budget.nodes = 0;
+    budget.restarts = 0;
+    budget.exhausted = false;
+
+    if (budget.timeLimit > 0)
+        budget.deadline = chrono::steady_clock::now() +
+                          chrono::microseconds(budget.timeLimit);
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Looks at the clock and the cancel flag. Returns false, and marks the budget
+ exhausted, if time is up or the search has been cancelled.
+
+**/
+/******************************************************************************/
+
+
+
+bool checkBudget(Budget &budget)
+{
+    if (budget.cancel != NULL && budget.cancel->load(memory_order_relaxed))
+        budget.exhausted = true;
+
+    if (budget.timeLimit > 0 && chrono::steady_clock::now() >= budget.deadline)
+        budget.exhausted = true;
+
+    return !budget.exhausted;
+}
+
+
+
+/// How a status reads in batch output
+const char *statusName(SolveStatus status)
+{
+    static const char *NAMES[] =
+    {
+        "solved", "no solution", "budget exhausted"
+    };
+
+    return NAMES[status];
+}
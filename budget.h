@@ -0,0 +1,77 @@
+/**
+  Name: budget.h
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Budgets for the searches, so one bad puzzle cannot hold up a
+  thread for ever. A budget can limit the nodes searched (guesses), the
+  restarts of bruteForce() or backtracks of a search, and the time taken, and
+  can hold a flag another thread sets to cancel the search, as the server
+  (server.h) does when a client hangs up. A search that runs out returns
+  SOLVE_EXHAUSTED, with what it found for sure kept, and the budget says how
+  much was spent.
+
+  The clock and the cancel flag are only looked at every CHECK_EVERY nodes
+  or restarts, so a budget costs the search next to nothing.
+*/
+
+#ifndef BUDGET_H
+#define BUDGET_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+enum SolveStatus { SOLVE_SOLVED, SOLVE_UNSOLVABLE, SOLVE_EXHAUSTED };
+
+const long CHECK_EVERY = 64;                // nodes between looks at the clock
+
+struct Budget
+{
+    long maxNodes;                          // 0 for no limit
+    long maxRestarts;                       // 0 for no limit
+    long timeLimit;                         // microseconds, 0 for no limit
+    const std::atomic<bool> *cancel;        // NULL for none
+
+    long nodes;                             // spent since startBudget()
+    long restarts;
+    bool exhausted;                         // stays set once run out
+    std::chrono::steady_clock::time_point deadline;
+};
+
+void initBudget(Budget &budget);
+void startBudget(Budget &budget);
+bool checkBudget(Budget &budget);
+const char *statusName(SolveStatus status);
+
+
+
+/// Spends a node, returning false if the budget has run out
+inline bool spendNode(Budget &budget)
+{
+    budget.nodes++;
+
+    if (budget.maxNodes > 0 && budget.nodes > budget.maxNodes)
+        budget.exhausted = true;
+    else if (budget.nodes % CHECK_EVERY == 0)
+        checkBudget(budget);
+
+    return !budget.exhausted;
+}
+
+
+
+/// Spends a restart or backtrack, returning false if the budget has run out
+inline bool spendRestart(Budget &budget)
+{
+    budget.restarts++;
+
+    if (budget.maxRestarts > 0 && budget.restarts > budget.maxRestarts)
+        budget.exhausted = true;
+    else if (budget.restarts % CHECK_EVERY == 0)
+        checkBudget(budget);
+
+    return !budget.exhausted;
+}
+
+#endif // BUDGET_H
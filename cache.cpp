@@ -0,0 +1,132 @@
+/**
+  Name: cache.cpp
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Cache of solutions to canonical puzzles. See cache.h.
+*/
+
+#include <cstring>
+
+#include "cache.h"
+
+using namespace std;
+
+
+
+/// 64 bit FNV-1a hash of a puzzle
+static uint64_t hashPuzzle(const unsigned char puzzle[])
+{
+    uint64_t hash = 0xCBF29CE484222325ULL;
+
+    for (int cell = 0; cell < CELLS; cell++)
+        hash = (hash ^ puzzle[cell]) * 0x100000001B3ULL;
+
+    return hash;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Empties the cache and sets how many solutions it keeps.
+
+**/
+/******************************************************************************/
+
+
+
+void initCache(SolutionCache &cache, size_t capacity)
+{
+    cache.capacity = capacity;
+    cache.entries.clear();
+    cache.index.clear();
+    cache.index.reserve(capacity);
+    cache.hits = 0;
+    cache.misses = 0;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Looks up the canonical puzzle. On a hit, copies its solution to solution,
+ sets solved to whether it has one, makes it the most recently used entry
+ and returns true. Returns false on a miss. Either way it is counted.
+
+**/
+/******************************************************************************/
+
+
+
+bool lookupSolution(SolutionCache &cache, const unsigned char puzzle[],
+                    unsigned char solution[], bool &solved)
+{
+    uint64_t hash = hashPuzzle(puzzle);
+    lock_guard<mutex> guard(cache.lock);
+    auto found = cache.index.find(hash);
+
+    if (found == cache.index.end() ||
+        memcmp(found->second->puzzle, puzzle, CELLS) != 0)
+    {
+        cache.misses++;
+        return false;
+    }
+
+    cache.entries.splice(cache.entries.begin(), cache.entries, found->second);
+
+    memcpy(solution, found->second->solution, CELLS);
+    solved = found->second->solved;
+
+    cache.hits++;
+
+    return true;
+}// end bool lookupSolution(SolutionCache &cache, const unsigned char puzzle[],
+//                         unsigned char solution[], bool &solved)
+
+
+
+/******************************************************************************/
+/**
+
+ Adds the solution of a canonical puzzle as the most recently used entry,
+ dropping the least recently used one if the cache is full. A different
+ puzzle with the same hash is replaced.
+
+**/
+/******************************************************************************/
+
+
+
+void storeSolution(SolutionCache &cache, const unsigned char puzzle[],
+                   const unsigned char solution[], bool solved)
+{
+    uint64_t hash = hashPuzzle(puzzle);
+    lock_guard<mutex> guard(cache.lock);
+    auto found = cache.index.find(hash);
+
+    if (cache.capacity == 0)
+        return;
+
+    if (found != cache.index.end())
+        cache.entries.erase(found->second);
+    else if (cache.entries.size() >= cache.capacity)
+    {
+        cache.index.erase(cache.entries.back().hash);
+        cache.entries.pop_back();
+    }
+
+    cache.entries.emplace_front();
+
+    CacheEntry &entry = cache.entries.front();
+
+    entry.hash = hash;
+    memcpy(entry.puzzle, puzzle, CELLS);
+    memcpy(entry.solution, solution, CELLS);
+    entry.solved = solved;
+
+    cache.index[hash] = cache.entries.begin();
+}// end void storeSolution(SolutionCache &cache, const unsigned char puzzle[],
+//                        const unsigned char solution[], bool solved)
@@ -0,0 +1,51 @@
+/**
+  Name: cache.h
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Cache of solutions to canonical puzzles (canonical.h), so a
+  puzzle that is only a relabelled or rearranged copy of one solved before
+  is not solved again. Entries are found by a 64 bit hash of the canonical
+  puzzle and checked against the whole puzzle, and once the cache is full
+  the entry used longest ago makes room for the new one.
+
+  One cache is shared by every batch thread, behind a lock held only while
+  looking up or adding an entry. It counts its hits and misses.
+*/
+
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "board.h"
+
+struct CacheEntry
+{
+    uint64_t hash;
+    unsigned char puzzle[CELLS];    // canonical puzzle, 0 for empty
+    unsigned char solution[CELLS];
+    bool solved;                    // false if the puzzle has no solution
+};
+
+struct SolutionCache
+{
+    size_t capacity;                        // most entries kept
+    std::list<CacheEntry> entries;          // most recently used first
+    std::unordered_map<uint64_t, std::list<CacheEntry>::iterator> index;
+    std::mutex lock;
+    long hits;
+    long misses;
+};
+
+void initCache(SolutionCache &cache, size_t capacity);
+bool lookupSolution(SolutionCache &cache, const unsigned char puzzle[],
+                    unsigned char solution[], bool &solved);
+void storeSolution(SolutionCache &cache, const unsigned char puzzle[],
+                   const unsigned char solution[], bool solved);
+
+#endif // CACHE_H
@@ -0,0 +1,345 @@
+/**
+  Name: canonical.cpp
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Canonical form of a puzzle. See canonical.h.
+*/
+
+#include <algorithm>
+#include <vector>
+
+#include "canonical.h"
+
+using namespace std;
+
+const int ORDERS = 6 * 6 * 6 * 6;           // column orders keeping stacks
+
+/// The 6 orders of 3 things
+const unsigned char PERMUTATIONS[6][BOX_SIZE] =
+{
+    { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 }
+};
+
+/// A way of arranging the board part way through: the rows picked so far,
+/// the column order and the relabelling of the numbers met so far
+struct Arrangement
+{
+    unsigned char rows[SIDE];
+    unsigned char label[SIDE + 1];  // 0 for a number not met yet
+    unsigned char next;             // label for the next new number
+    bool transposed;
+    short order;                    // index into ColumnOrders
+};
+
+
+
+/******************************************************************************/
+/**
+
+ Every order of the columns that keeps each stack of three together: the
+ stacks in any order, and the columns of each stack in any order. Built by
+ the compiler.
+
+**/
+/******************************************************************************/
+
+
+
+struct ColumnOrders
+{
+    unsigned char col[ORDERS][SIDE];
+};
+
+
+
+constexpr ColumnOrders makeColumnOrders()
+{
+    ColumnOrders orders = {};
+
+    for (int o = 0; o < ORDERS; o++)
+    {
+        int stacks = o / (6 * 6 * 6), within[BOX_SIZE] =
+        {
+            o / (6 * 6) % 6, o / 6 % 6, o % 6
+        };
+
+        for (int s = 0; s < BOX_SIZE; s++)
+            for (int c = 0; c < BOX_SIZE; c++)
+                orders.col[o][s * BOX_SIZE + c] = (unsigned char)(
+                    PERMUTATIONS[stacks][s] * BOX_SIZE +
+                    PERMUTATIONS[within[s]][c]);
+    }
+
+    return orders;
+}
+
+constexpr ColumnOrders COLUMN_ORDERS = makeColumnOrders();
+
+
+
+/// Which of the 3 squares of a stack are filled, as a 3 bit number read
+/// from the left, for each set of filled squares and each of their orders
+struct FilledPatterns
+{
+    unsigned char pattern[1 << BOX_SIZE][6];
+};
+
+constexpr FilledPatterns makeFilledPatterns()
+{
+    FilledPatterns filled = {};
+
+    for (int mask = 0; mask < 1 << BOX_SIZE; mask++)
+        for (int w = 0; w < 6; w++)
+            for (int j = 0; j < BOX_SIZE; j++)
+                filled.pattern[mask][w] |= (unsigned char)(
+                    ((mask >> PERMUTATIONS[w][j]) & 1) << (BOX_SIZE - 1 - j));
+
+    return filled;
+}
+
+constexpr FilledPatterns FILLED = makeFilledPatterns();
+
+
+
+/******************************************************************************/
+/**
+
+ Finds the canonical form of the puzzle in the array (see canonical.h).
+
+ Every column order is tried, on the board as it is and on its side. For
+ each of them the rows are picked one at a time: any row of a band not used
+ yet to start a band, otherwise one of the rows left in the band being
+ filled. Each row is relabelled as it is read, and only the arrangements
+ whose rows so far read smallest are kept for the next row. Ties between
+ arrangements are common at first, while few numbers have been met, but
+ they die out within a few rows.
+
+ The first row has every row and every column order to choose from, and
+ costs more than all the others together if done the same way. Its numbers
+ are all new, so it reads 1, 2, 3... wherever it is not empty, and the
+ smallest first rows are simply the ones with the most empty squares first:
+ the smallest pattern of filled squares, worked out a stack at a time.
+
+**/
+/******************************************************************************/
+
+
+
+void canonicalize(const int arr[][SIDE], Canonical &canon)
+{
+    unsigned char grid[2][CELLS], best[SIDE], line[SIDE];
+    vector<Arrangement> arrangements, kept;
+    const unsigned char *col;
+    int stack[2][SIDE][BOX_SIZE] = {}, rowSmallest[2][SIDE];
+    int next, smallest = 1 << SIDE;
+
+    for (int cell = 0; cell < CELLS; cell++)
+    {
+        grid[0][cell] = (unsigned char)arr[rowOf(cell)][colOf(cell)];
+        grid[1][colOf(cell) * SIDE + rowOf(cell)] = grid[0][cell];
+    }
+
+    arrangements.reserve(2 * ORDERS);
+    kept.reserve(2 * ORDERS);
+
+    /// The smallest pattern a row can be arranged into has the stacks with
+    /// the fewest filled squares first, and their filled squares last
+    for (int t = 0; t < 2; t++)
+        for (int r = 0; r < SIDE; r++)
+        {
+            int count[BOX_SIZE] = {};
+
+            for (int c = 0; c < SIDE; c++)
+                if (grid[t][r * SIDE + c] != 0)
+                {
+                    stack[t][r][c / BOX_SIZE] |= 1 << (c % BOX_SIZE);
+                    count[c / BOX_SIZE]++;
+                }
+
+            sort(count, count + BOX_SIZE);
+
+            rowSmallest[t][r] = 0;
+
+            for (int s = 0; s < BOX_SIZE; s++)
+                rowSmallest[t][r] = rowSmallest[t][r] << BOX_SIZE |
+                                    ((1 << count[s]) - 1);
+
+            smallest = min(smallest, rowSmallest[t][r]);
+        }
+
+
+    /// Every row and column order that gives it starts an arrangement
+    for (int t = 0; t < 2; t++)
+        for (int r = 0; r < SIDE; r++)
+        {
+            const int *bits = stack[t][r];
+
+            if (rowSmallest[t][r] != smallest)
+                continue;
+
+            for (int o = 0; o < ORDERS; o++)
+            {
+                const unsigned char *stacks = PERMUTATIONS[o / 216];
+
+                if ((FILLED.pattern[bits[stacks[0]]][o / 36 % 6] << 6 |
+                     FILLED.pattern[bits[stacks[1]]][o / 6 % 6] << 3 |
+                     FILLED.pattern[bits[stacks[2]]][o % 6]) != smallest)
+                    continue;
+
+                Arrangement start = {};
+
+                start.rows[0] = (unsigned char)r;
+                start.next = 1;
+                start.transposed = t == 1;
+                start.order = short(o);
+
+                col = COLUMN_ORDERS.col[o];
+
+                for (int c = 0; c < SIDE; c++)
+                {
+                    int value = grid[t][r * SIDE + col[c]];
+
+                    if (value != 0)
+                        start.label[value] = start.next++;
+                }
+
+                arrangements.push_back(start);
+
+            }// end for (int o = 0; o < ORDERS; o++)
+
+        }// end for (int r = 0; r < SIDE; r++)
+
+
+    for (int k = 1; k < SIDE; k++)
+    {
+        bool found = false;
+
+        kept.clear();
+
+        for (size_t a = 0; a < arrangements.size(); a++)
+        {
+            const Arrangement &so = arrangements[a];
+            const unsigned char *g = grid[so.transposed];
+            int used = 0, bands = 0;
+
+            col = COLUMN_ORDERS.col[so.order];
+
+            for (int j = 0; j < k; j++)
+            {
+                used |= 1 << so.rows[j];
+                bands |= 1 << (so.rows[j] / BOX_SIZE);
+            }
+
+            for (int r = 0; r < SIDE; r++)
+            {
+                Arrangement then = so;
+                int compare = found ? 0 : -1;
+
+                if (used & (1 << r))
+                    continue;
+
+                /// A band is finished before the next one is started
+                if (k % BOX_SIZE != 0
+                        ? r / BOX_SIZE != so.rows[k - 1] / BOX_SIZE
+                        : (bands & (1 << (r / BOX_SIZE))) != 0)
+                    continue;
+
+                for (int c = 0; c < SIDE && compare <= 0; c++)
+                {
+                    int value = g[r * SIDE + col[c]];
+
+                    if (value != 0 && then.label[value] == 0)
+                        then.label[value] = then.next++;
+
+                    line[c] = then.label[value];
+
+                    if (compare == 0 && line[c] != best[c])
+                        compare = line[c] < best[c] ? -1 : 1;
+                }
+
+                if (compare > 0)
+                    continue;
+
+                if (compare < 0)
+                {
+                    for (int c = 0; c < SIDE; c++)
+                        best[c] = line[c];
+
+                    found = true;
+                    kept.clear();
+                }
+
+                then.rows[k] = (unsigned char)r;
+                kept.push_back(then);
+
+            }// end for (int r = 0; r < SIDE; r++)
+
+        }// end for (size_t a = 0; a < arrangements.size(); a++)
+
+        arrangements.swap(kept);
+
+    }// end for (int k = 1; k < SIDE; k++)
+
+
+    /// Any arrangement left gives the same canonical puzzle
+    const Arrangement &chosen = arrangements[0];
+
+    col = COLUMN_ORDERS.col[chosen.order];
+
+    canon.transposed = chosen.transposed;
+
+    for (int i = 0; i < SIDE; i++)
+    {
+        canon.row[i] = chosen.rows[i];
+        canon.col[i] = col[i];
+    }
+
+    for (int cell = 0; cell < CELLS; cell++)
+        canon.value[cell] = chosen.label[grid[chosen.transposed]
+                                            [canon.row[rowOf(cell)] * SIDE +
+                                             canon.col[colOf(cell)]]];
+
+
+    /// Numbers the puzzle does not give take the labels left over
+    next = chosen.next;
+
+    canon.digit[0] = 0;
+
+    for (int d = 1; d <= SIDE; d++)
+    {
+        if (chosen.label[d] != 0)
+            canon.digit[chosen.label[d]] = (unsigned char)d;
+        else
+            canon.digit[next++] = (unsigned char)d;
+    }
+}// end void canonicalize(const int arr[][SIDE], Canonical &canon)
+
+
+
+/******************************************************************************/
+/**
+
+ Puts values, 81 squares in the arrangement and labels of the canonical
+ puzzle, back the way the puzzle was given and into the array. Used to turn
+ a solution of the canonical puzzle into a solution of the original.
+
+**/
+/******************************************************************************/
+
+
+
+void fromCanonical(const Canonical &canon, const unsigned char values[],
+                   int arr[][SIDE])
+{
+    for (int cell = 0; cell < CELLS; cell++)
+    {
+        int r = canon.row[rowOf(cell)], c = canon.col[colOf(cell)];
+        int digit = canon.digit[values[cell]];
+
+        if (canon.transposed)
+            arr[c][r] = digit;
+        else
+            arr[r][c] = digit;
+    }
+}
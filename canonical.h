@@ -0,0 +1,41 @@
+/**
+  Name: canonical.h
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Canonical form of a puzzle. Swapping rows within a band of
+  three, swapping bands, doing the same with columns and stacks, turning the
+  board on its side and relabelling the numbers all give a puzzle that is
+  solved the same way. canonicalize() picks one representative out of all
+  of them, the same whichever of them it is given, so puzzles that are only
+  relabelled or rearranged copies of each other can share one solution
+  (cache.h).
+
+  The representative is the one that reads smallest, left to right and top
+  to bottom, once its numbers are relabelled 1, 2, 3... in the order they
+  are first met, with empty squares as 0. It is found a row at a time,
+  keeping only the arrangements that tie for the smallest rows so far.
+
+  fromCanonical() undoes the arrangement and relabelling, so a solution of
+  the canonical puzzle becomes a solution of the puzzle that was given.
+*/
+
+#ifndef CANONICAL_H
+#define CANONICAL_H
+
+#include "board.h"
+
+struct Canonical
+{
+    unsigned char value[CELLS];     // the canonical puzzle, 0 for empty
+    bool transposed;                // turned on its side first
+    unsigned char row[SIDE];        // row each canonical row was taken from
+    unsigned char col[SIDE];        // and column for each canonical column
+    unsigned char digit[SIDE + 1];  // original number of each canonical one
+};
+
+void canonicalize(const int arr[][SIDE], Canonical &canon);
+void fromCanonical(const Canonical &canon, const unsigned char values[],
+                   int arr[][SIDE]);
+
+#endif // CANONICAL_H
@@ -0,0 +1,177 @@
+/**
+  Name: client.cpp
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Test client for the solver daemon (server.h). Connects to the
+  daemon's Unix domain socket, sends every line of a file without waiting for
+  the replies, and reads the replies back as they come. The replies go to
+  standard output; how many came back with each status, and requests per
+  second, go to standard error.
+
+  Usage: client socket file|-
+
+  Compile with:
+
+  g++ -O2 -pthread -o client client.cpp
+*/
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+const int STATUSES = 5;                     // reply status codes, server.h
+
+
+
+/// Writes all of data to fd, returning false if it cannot
+static bool writeAll(int fd, const char *data, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t written = write(fd, data, size);
+
+        if (written < 0 && errno == EINTR)
+            continue;
+
+        if (written <= 0)
+            return false;
+
+        data += written;
+        size -= size_t(written);
+    }
+
+    return true;
+}
+
+
+
+/// Connects to the daemon listening at path, returning -1 if it cannot
+static int connectTo(const char *path)
+{
+    struct sockaddr_un address;
+    int fd;
+
+    if (strlen(path) >= sizeof address.sun_path)
+        return -1;
+
+    memset(&address, 0, sizeof address);
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path);
+
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (fd >= 0 &&
+        connect(fd, (struct sockaddr *)&address, sizeof address) != 0)
+    {
+        close(fd);
+        fd = -1;
+    }
+
+    return fd;
+}
+
+
+
+int main(int argc, char *argv[])
+{
+    string requests, pending, line;
+    long replies = 0, counts[STATUSES + 1] = { 0 };
+    char buffer[64 * 1024];
+    int fd;
+
+    if (argc != 3)
+    {
+        cerr << "usage: " << argv[0] << " socket file|-" << endl;
+        return 1;
+    }
+
+    if (string(argv[2]) == "-")
+        while (getline(cin, line))
+            requests += line + '\n';
+    else
+    {
+        ifstream file(argv[2]);
+
+        if (!file)
+        {
+            cerr << "unable to open " << argv[2] << endl;
+            return 1;
+        }
+
+        while (getline(file, line))
+            requests += line + '\n';
+    }
+
+    fd = connectTo(argv[1]);
+
+    if (fd < 0)
+    {
+        cerr << "unable to connect to " << argv[1] << ": " << strerror(errno)
+             << endl;
+        return 1;
+    }
+
+    auto start = chrono::steady_clock::now();
+
+
+    /// Sending on a thread of its own keeps the daemon's replies flowing
+    /// back while the rest of the requests are still going out
+    thread writer([&]
+    {
+        writeAll(fd, requests.data(), requests.size());
+        shutdown(fd, SHUT_WR);
+    });
+
+    for (;;)
+    {
+        ssize_t got = read(fd, buffer, sizeof buffer);
+        size_t begin = 0, newline;
+
+        if (got < 0 && errno == EINTR)
+            continue;
+
+        if (got <= 0)
+            break;
+
+        pending.append(buffer, size_t(got));
+
+        while ((newline = pending.find('\n', begin)) != string::npos)
+        {
+            int status = pending[begin] - '0';
+
+            counts[status >= 0 && status < STATUSES ? status : STATUSES]++;
+            replies++;
+            begin = newline + 1;
+        }
+
+        cout.write(pending.data(), begin);
+        pending.erase(0, begin);
+    }
+
+    writer.join();
+    close(fd);
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() -
+                                              start).count();
+
+    cerr << replies << " replies: " << counts[0] << " solved, " << counts[1]
+         << " no solution, " << counts[2] << " malformed, " << counts[3]
+         << " unknown, " << counts[4] << " out of budget, "
+         << counts[STATUSES] << " other" << endl;
+    cerr << fixed << setprecision(0) << replies / seconds
+         << " requests per second" << endl;
+
+    return 0;
+}
@@ -0,0 +1,165 @@
+/**
+  Name: corpus.cpp
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Puzzle line parsing and formatting. See corpus.h.
+*/
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "corpus.h"
+
+using namespace std;
+
+
+
+/******************************************************************************/
+/**
+
+ Fills the array from one line of text, the same way fillBoard() does from
+ data.txt. Trailing spaces, tabs and carriage returns are ignored. Returns
+ false with the reason in error if the line is not 81 squares long or has a
+ character other than a number, '0' or '.'. Whether the numbers clash is left
+ to initBoard().
+
+**/
+/******************************************************************************/
+
+
+
+bool parsePuzzle(const char *text, size_t length, int arr[][SIDE],
+                 string &error)
+{
+    while (length > 0 && (text[length - 1] == ' ' || text[length - 1] == '\t' ||
+                          text[length - 1] == '\r'))
+        length--;
+
+    if (length != CELLS)
+    {
+        error = "expected " + to_string(CELLS) + " squares, found " +
+                to_string(length);
+        return false;
+    }
+
+    for (int cell = 0; cell < CELLS; cell++)
+    {
+        char c = text[cell];
+
+        if (c >= '1' && c <= '9')
+            arr[rowOf(cell)][colOf(cell)] = c - '0';
+        else if (c == '0' || c == '.')
+            arr[rowOf(cell)][colOf(cell)] = 0;
+        else
+        {
+            error = "invalid character '" + string(1, c) + "' at square " +
+                    to_string(cell + 1);
+            return false;
+        }
+    }// end for (int cell = 0; cell < CELLS; cell++)
+
+    return true;
+}// end bool parsePuzzle(const char *text, size_t length, int arr[][SIDE],
+//                      string &error)
+
+
+
+/******************************************************************************/
+/**
+
+ Writes the board as 81 characters to out, '.' for an empty square. No
+ newline or terminating zero is added.
+
+**/
+/******************************************************************************/
+
+
+
+void writeBoard(const Board &board, char *out)
+{
+    for (int cell = 0; cell < CELLS; cell++)
+        out[cell] = board.value[cell] ? char('0' + board.value[cell]) : '.';
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Maps the file called name into memory, read only, and tells the kernel it
+ will be read from start to end. Returns false, leaving file empty, if the
+ file cannot be opened, is empty or is not a regular file, or on systems
+ without mmap().
+
+**/
+/******************************************************************************/
+
+
+
+bool mapFile(const char *name, MappedFile &file)
+{
+    file.data = NULL;
+    file.size = 0;
+
+#if defined(_WIN32)
+    (void)name;
+
+    return false;
+#else
+    struct stat info;
+    void *mapping;
+    int fd = open(name, O_RDONLY);
+
+    if (fd < 0)
+        return false;
+
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size == 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    mapping = mmap(NULL, size_t(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+    /// The mapping keeps the file open by itself
+    close(fd);
+
+    if (mapping == MAP_FAILED)
+        return false;
+
+    madvise(mapping, size_t(info.st_size), MADV_SEQUENTIAL);
+
+    file.data = static_cast<const char *>(mapping);
+    file.size = size_t(info.st_size);
+
+    return true;
+#endif
+}// end bool mapFile(const char *name, MappedFile &file)
+
+
+
+/******************************************************************************/
+/**
+
+ Unmaps a file mapped by mapFile().
+
+**/
+/******************************************************************************/
+
+
+
+void unmapFile(MappedFile &file)
+{
+#if !defined(_WIN32)
+    if (file.data != NULL)
+        munmap(const_cast<char *>(file.data), file.size);
+#endif
+
+    file.data = NULL;
+    file.size = 0;
+}
@@ -0,0 +1,37 @@
+/**
+  Name: corpus.h
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Reading and writing puzzles in the one puzzle per line format
+  used by most puzzle collections: 81 characters, left to right and top to
+  bottom, a number for a filled square and '0' or '.' for an empty one.
+
+  mapFile() maps a whole file into memory read only, so big collections can
+  be parsed straight out of the mapping without copying them. It fails for
+  anything that cannot be mapped, such as a pipe, and the caller reads the
+  file as a stream instead.
+*/
+
+#ifndef CORPUS_H
+#define CORPUS_H
+
+#include <cstddef>
+#include <string>
+
+#include "board.h"
+
+bool parsePuzzle(const char *text, size_t length, int arr[][SIDE],
+                 std::string &error);
+void writeBoard(const Board &board, char *out);
+
+struct MappedFile
+{
+    const char *data;
+    size_t size;
+};
+
+bool mapFile(const char *name, MappedFile &file);
+void unmapFile(MappedFile &file);
+
+#endif // CORPUS_H
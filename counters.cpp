@@ -0,0 +1,210 @@
+/**
+  Name: counters.cpp
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Per thread performance counters. See counters.h.
+*/
+
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+#include "counters.h"
+
+using namespace std;
+
+bool countersOn = false;
+
+/// Every thread's counters, kept until the program ends so the counts of a
+/// thread that has finished still add up
+static vector<ThreadCounters *> everyThread;
+static mutex everyThreadLock;
+
+static const char *STAGE_NAMES[STAGES] =
+{
+    "naked_singles", "hidden_singles", "locked_candidates", "subsets", "fish",
+    "brute_force", "search"
+};
+
+static const char *COUNTER_NAMES[COUNTERS] =
+{
+    "placements", "eliminations", "passes", "guesses", "restarts", "ns"
+};
+
+static const char *COUNTER_HELP[COUNTERS] =
+{
+    "Numbers placed", "Potential numbers eliminated", "Passes made",
+    "Guesses made", "Restarts or backtracks", "Time spent"
+};
+
+
+
+/******************************************************************************/
+/**
+
+ Turns the counters on. Must be called before any solving thread starts.
+
+**/
+/******************************************************************************/
+
+
+
+void startCounters()
+{
+    countersOn = true;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ The counters of the calling thread, made and registered the first time the
+ thread asks for them.
+
+**/
+/******************************************************************************/
+
+
+
+ThreadCounters *localCounters()
+{
+    static thread_local ThreadCounters *mine = NULL;
+
+    if (mine == NULL)
+    {
+        mine = new ThreadCounters;
+
+        for (int s = 0; s < STAGES; s++)
+            for (int c = 0; c < COUNTERS; c++)
+                mine->count[s][c].store(0, memory_order_relaxed);
+
+        lock_guard<mutex> guard(everyThreadLock);
+        everyThread.push_back(mine);
+    }
+
+    return mine;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Adds up the counters of every thread into totals. The threads may still be
+ counting, so each total is as of some moment during the call.
+
+**/
+/******************************************************************************/
+
+
+
+void collectCounters(long totals[STAGES][COUNTERS])
+{
+    lock_guard<mutex> guard(everyThreadLock);
+
+    for (int s = 0; s < STAGES; s++)
+        for (int c = 0; c < COUNTERS; c++)
+        {
+            totals[s][c] = 0;
+
+            for (size_t t = 0; t < everyThread.size(); t++)
+                totals[s][c] +=
+                    everyThread[t]->count[s][c].load(memory_order_relaxed);
+        }
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Reads "json" or "prometheus" into format. Returns false for anything else.
+
+**/
+/******************************************************************************/
+
+
+
+bool parseCounterFormat(const string &name, CounterFormat &format)
+{
+    if (name == "json")
+        format = COUNTERS_JSON;
+    else if (name == "prometheus")
+        format = COUNTERS_PROMETHEUS;
+    else
+        return false;
+
+    return true;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Writes the totals of every thread's counters to out in format. JSON is one
+ line, an object of stages each holding its counters, e.g.
+ {"naked_singles":{"placements":51,...,"ns":1200},...}. Prometheus text has
+ one counter per kind of count, labelled by stage, with the time in seconds,
+ e.g. sudoku_placements_total{stage="naked_singles"} 51, one per line and
+ every line ending in a newline.
+
+**/
+/******************************************************************************/
+
+
+
+void writeCounters(CounterFormat format, string &out)
+{
+    long totals[STAGES][COUNTERS];
+    char number[32];
+
+    collectCounters(totals);
+
+    if (format == COUNTERS_JSON)
+    {
+        out += '{';
+
+        for (int s = 0; s < STAGES; s++)
+        {
+            out += string(s > 0 ? "," : "") + '"' + STAGE_NAMES[s] + "\":{";
+
+            for (int c = 0; c < COUNTERS; c++)
+                out += string(c > 0 ? "," : "") + '"' + COUNTER_NAMES[c] +
+                       "\":" + to_string(totals[s][c]);
+
+            out += '}';
+        }
+
+        out += '}';
+    }
+    else if (format == COUNTERS_PROMETHEUS)
+    {
+        for (int c = 0; c < COUNTERS; c++)
+        {
+            string name = string("sudoku_") +
+                          (c == COUNT_NS ? "seconds" : COUNTER_NAMES[c]) +
+                          "_total";
+
+            out += "# HELP " + name + ' ' + COUNTER_HELP[c] +
+                   " by each stage of solving.\n";
+            out += "# TYPE " + name + " counter\n";
+
+            for (int s = 0; s < STAGES; s++)
+            {
+                if (c == COUNT_NS)
+                    snprintf(number, sizeof number, "%.9f",
+                             totals[s][c] / 1e9);
+                else
+                    snprintf(number, sizeof number, "%ld", totals[s][c]);
+
+                out += name + "{stage=\"" + STAGE_NAMES[s] + "\"} " + number +
+                       '\n';
+            }
+        }
+
+    }// end else if (format == COUNTERS_PROMETHEUS)
+
+}// end void writeCounters(CounterFormat format, string &out)
@@ -0,0 +1,140 @@
+/**
+  Name: counters.h
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Performance counters for each stage of solving: how many
+  numbers it placed and potential numbers it eliminated, how many passes it
+  made, how many guesses and restarts or backtracks, and how long it took in
+  all, in nanoseconds.
+
+  Every thread counts into a block of its own, so counting takes no locks and
+  the threads never share a cache line. The blocks are only added up when the
+  counters are written out. Until startCounters() is called nothing is
+  counted or timed, and each stage only checks countersOn.
+
+  A pass is one sweep of a stage over the whole board. The singles and
+  locked candidates of solve() (logic.h) go over one number at a time, so
+  their time is added up for each number and the pass counted once all nine
+  are done.
+
+  The search (search.h) counts the numbers its propagate() places, its passes
+  and their time under the singles stages. The time of the search as a whole
+  takes them in too, so the times of the stages add up to more than the time
+  spent solving.
+
+  The totals can be written as one line of JSON or as Prometheus text.
+*/
+
+#ifndef COUNTERS_H
+#define COUNTERS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+enum Stage
+{
+    STAGE_NAKED_SINGLES,        // solve(), and propagate() (search.h)
+    STAGE_HIDDEN_SINGLES,       // actualAddAndElimPotentialElim(), and
+                                // propagate()
+    STAGE_LOCKED_CANDIDATES,    // its pointing and claiming
+    STAGE_SUBSETS,              // subsets()
+    STAGE_FISH,                 // fish()
+    STAGE_BRUTE_FORCE,          // bruteForce()
+    STAGE_SEARCH,               // depthFirst(), with its propagate()
+    STAGES
+};
+
+enum Counter
+{
+    COUNT_PLACEMENTS,
+    COUNT_ELIMINATIONS,
+    COUNT_PASSES,
+    COUNT_GUESSES,
+    COUNT_RESTARTS,             // restarts of bruteForce(), backtracks of a
+                                // search
+    COUNT_NS,
+    COUNTERS
+};
+
+enum CounterFormat { COUNTERS_OFF, COUNTERS_JSON, COUNTERS_PROMETHEUS };
+
+/// One thread's counts. Only its own thread writes them; the atomics just
+/// let another thread read them while they are being written.
+struct alignas(64) ThreadCounters
+{
+    std::atomic<long> count[STAGES][COUNTERS];
+};
+
+extern bool countersOn;
+
+void startCounters();
+ThreadCounters *localCounters();
+void collectCounters(long totals[STAGES][COUNTERS]);
+bool parseCounterFormat(const std::string &name, CounterFormat &format);
+void writeCounters(CounterFormat format, std::string &out);
+
+
+
+/// The counters of the calling thread, or NULL if nothing is being counted
+inline ThreadCounters *stageCounters()
+{
+    return countersOn ? localCounters() : NULL;
+}
+
+
+
+/// Adds amount to a counter, if counting. Only the owning thread writes, so
+/// a plain load and store is enough and costs no more than an ordinary add.
+inline void addCount(ThreadCounters *counters, Stage stage, Counter counter,
+                     long amount = 1)
+{
+    if (counters == NULL)
+        return;
+
+    std::atomic<long> &count = counters->count[stage][counter];
+
+    count.store(count.load(std::memory_order_relaxed) + amount,
+                std::memory_order_relaxed);
+}
+
+
+
+/// When a pass of a stage starts, in nanoseconds on a clock that only goes
+/// forward, or 0 if not counting
+inline long startPass(ThreadCounters *counters)
+{
+    if (counters == NULL)
+        return 0;
+
+    return long(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+
+
+/// Adds the time since started to stage without counting a pass, for a
+/// pass that is timed in pieces
+inline void addTime(ThreadCounters *counters, Stage stage, long started)
+{
+    if (counters == NULL)
+        return;
+
+    addCount(counters, stage, COUNT_NS, startPass(counters) - started);
+}
+
+
+
+/// Counts a pass of stage that began at started, and the time it took
+inline void endPass(ThreadCounters *counters, Stage stage, long started)
+{
+    if (counters == NULL)
+        return;
+
+    addCount(counters, stage, COUNT_PASSES);
+    addTime(counters, stage, started);
+}
+
+#endif // COUNTERS_H
@@ -0,0 +1,359 @@
+/**
+  Name: dlx.cpp
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Dancing Links search. See dlx.h.
+
+  Node 0 is the root, nodes 1 - 324 are the column headers and the rest are
+  the 4 nodes of each candidate row. Candidate row cell * 9 + digit - 1 puts
+  digit on cell and covers columns:
+
+      1 + cell                          the square is filled
+      1 + 81 + row * 9 + digit - 1      the row has the number
+      1 + 162 + column * 9 + digit - 1  the column has the number
+      1 + 243 + grid * 9 + digit - 1    the 3x3 grid has the number
+*/
+
+#include "dlx.h"
+
+
+
+/******************************************************************************/
+/**
+
+ Removes column c from the header list and every row that has a node in
+ column c from the other columns it is in.
+
+**/
+/******************************************************************************/
+
+
+
+static void cover(Dlx &dlx, int c)
+{
+    dlx.left[dlx.right[c]] = dlx.left[c];
+    dlx.right[dlx.left[c]] = dlx.right[c];
+
+    for (int i = dlx.down[c]; i != c; i = dlx.down[i])
+        for (int j = dlx.right[i]; j != i; j = dlx.right[j])
+        {
+            dlx.up[dlx.down[j]] = dlx.up[j];
+            dlx.down[dlx.up[j]] = dlx.down[j];
+            dlx.size[dlx.column[j]]--;
+        }
+}// end static void cover(Dlx &dlx, int c)
+
+
+
+/******************************************************************************/
+/**
+
+ Puts column c back, undoing cover() in exactly the reverse order.
+
+**/
+/******************************************************************************/
+
+
+
+static void uncover(Dlx &dlx, int c)
+{
+    for (int i = dlx.up[c]; i != c; i = dlx.up[i])
+        for (int j = dlx.left[i]; j != i; j = dlx.left[j])
+        {
+            dlx.size[dlx.column[j]]++;
+            dlx.up[dlx.down[j]] = j;
+            dlx.down[dlx.up[j]] = j;
+        }
+
+    dlx.left[dlx.right[c]] = c;
+    dlx.right[dlx.left[c]] = c;
+}// end static void uncover(Dlx &dlx, int c)
+
+
+
+/******************************************************************************/
+/**
+
+ Links all the nodes of the exact cover matrix. Only needs to be done once,
+ solving leaves the links the way it found them.
+
+**/
+/******************************************************************************/
+
+
+
+void initDlx(Dlx &dlx)
+{
+    int node = DLX_COLUMNS + 1;
+
+    /// The root and column headers form one circular list, each header
+    /// starting out as an empty column
+    for (int c = 0; c <= DLX_COLUMNS; c++)
+    {
+        dlx.left[c] = c == 0 ? DLX_COLUMNS : c - 1;
+        dlx.right[c] = c == DLX_COLUMNS ? 0 : c + 1;
+        dlx.up[c] = c;
+        dlx.down[c] = c;
+        dlx.column[c] = c;
+        dlx.row[c] = -1;
+        dlx.size[c] = 0;
+    }
+
+
+    /// Each candidate row gets 4 nodes linked in a circle, each one added
+    /// to the bottom of its column
+    for (int r = 0; r < DLX_ROWS; r++)
+    {
+        int cell = r / SIDE, d = r % SIDE, columns[4];
+
+        columns[0] = 1 + cell;
+        columns[1] = 1 + CELLS + rowOf(cell) * SIDE + d;
+        columns[2] = 1 + 2 * CELLS + colOf(cell) * SIDE + d;
+        columns[3] = 1 + 3 * CELLS + boxOf(cell) * SIDE + d;
+
+        dlx.rowStart[r] = node;
+
+        for (int i = 0; i < 4; i++, node++)
+        {
+            int c = columns[i];
+
+            dlx.left[node] = i == 0 ? node + 3 : node - 1;
+            dlx.right[node] = i == 3 ? node - 3 : node + 1;
+
+            dlx.up[node] = dlx.up[c];
+            dlx.down[node] = c;
+            dlx.down[dlx.up[c]] = node;
+            dlx.up[c] = node;
+
+            dlx.column[node] = c;
+            dlx.row[node] = r;
+            dlx.size[c]++;
+        }
+
+    }// end for (int r = 0; r < DLX_ROWS; r++)
+
+    dlx.depth = 0;
+}// end void initDlx(Dlx &dlx)
+
+
+
+/******************************************************************************/
+/**
+
+ A covered column has been unlinked from the header list, so its neighbours
+ no longer point back at it.
+
+**/
+/******************************************************************************/
+
+
+
+static bool covered(Dlx &dlx, int c)
+{
+    return dlx.right[dlx.left[c]] != c;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Algorithm X. Picks the column with the fewest nodes left and tries each of
+ its rows in turn. The rows of the first solution found are left in chosen.
+ Everything covered is uncovered again before returning, found or not. Every
+ row tried is spent from budget, if there is one, and once it runs out the
+ search unwinds without finding anything.
+
+**/
+/******************************************************************************/
+
+
+
+static bool search(Dlx &dlx, Budget *budget)
+{
+    int c = 0, fewest = DLX_ROWS + 1;
+    bool found = false;
+
+    if (dlx.right[0] == 0)
+        return true;
+
+    for (int i = dlx.right[0]; i != 0; i = dlx.right[i])
+        if (dlx.size[i] < fewest)
+        {
+            c = i;
+            fewest = dlx.size[i];
+        }
+
+    if (fewest == 0)
+        return false;
+
+    cover(dlx, c);
+
+    for (int r = dlx.down[c]; r != c && !found; r = dlx.down[r])
+    {
+        if (budget != NULL && !spendNode(*budget))
+            break;
+
+        dlx.chosen[dlx.depth++] = dlx.row[r];
+
+        for (int j = dlx.right[r]; j != r; j = dlx.right[j])
+            cover(dlx, dlx.column[j]);
+
+        found = search(dlx, budget);
+
+        for (int j = dlx.left[r]; j != r; j = dlx.left[j])
+            uncover(dlx, dlx.column[j]);
+
+        if (!found)
+            dlx.depth--;
+    }
+
+    uncover(dlx, c);
+
+    return found;
+}// end static bool search(Dlx &dlx, Budget *budget)
+
+
+
+/******************************************************************************/
+/**
+
+ Solves the board. The numbers already on the board are picked first, then
+ Algorithm X fills in the rest, within budget if there is one. Returns true
+ with the board solved, or false, leaving the board unchanged, if there is
+ no solution or the budget ran out.
+
+**/
+/******************************************************************************/
+
+
+
+static bool coverAndSearch(Dlx &dlx, Board &board, Budget *budget)
+{
+    int givens = 0, start;
+    bool found, clash = false;
+
+
+    /// Picks the candidate row of every number on the board. A number used
+    /// twice in a row, column or 3x3 grid would need a column that is
+    /// already covered, which means there is no solution.
+    for (int cell = 0; cell < CELLS && clash == false; cell++)
+    {
+        int digit = board.value[cell];
+
+        if (digit == 0)
+            continue;
+
+        start = dlx.rowStart[cell * SIDE + digit - 1];
+
+        for (int j = dlx.right[start]; j != start; j = dlx.right[j])
+            if (covered(dlx, dlx.column[j]))
+                clash = true;
+
+        if (clash)
+            break;
+
+        cover(dlx, dlx.column[start]);
+
+        for (int j = dlx.right[start]; j != start; j = dlx.right[j])
+            cover(dlx, dlx.column[j]);
+
+        dlx.chosen[givens++] = cell * SIDE + digit - 1;
+
+    }// end for (int cell = 0; cell < CELLS && clash == false; cell++)
+
+    dlx.depth = givens;
+
+    found = !clash && search(dlx, budget);
+
+
+    /// Copies the solution over before the givens are uncovered
+    if (found)
+    {
+        for (int i = givens; i < CELLS; i++)
+            placeDigit(board, dlx.chosen[i] / SIDE,
+                       dlx.chosen[i] % SIDE + 1);
+    }
+
+
+    /// Uncovers the givens in the reverse order they were covered
+    for (int i = givens - 1; i >= 0; i--)
+    {
+        start = dlx.rowStart[dlx.chosen[i]];
+
+        for (int j = dlx.left[start]; j != start; j = dlx.left[j])
+            uncover(dlx, dlx.column[j]);
+
+        uncover(dlx, dlx.column[start]);
+    }
+
+    dlx.depth = 0;
+
+    return found;
+}// end static bool coverAndSearch(Dlx &dlx, Board &board, Budget *budget)
+
+
+
+/******************************************************************************/
+/**
+
+ Solves the board. Returns true with the board solved, or false, leaving the
+ board unchanged, if there is no solution.
+
+**/
+/******************************************************************************/
+
+
+
+bool dlxSolve(Dlx &dlx, Board &board)
+{
+    return coverAndSearch(dlx, board, NULL);
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Solves the board within budget. Returns SOLVE_SOLVED with the board solved,
+ or SOLVE_UNSOLVABLE or SOLVE_EXHAUSTED with the board unchanged.
+
+**/
+/******************************************************************************/
+
+
+
+SolveStatus dlxSolve(Dlx &dlx, Board &board, Budget &budget)
+{
+    if (coverAndSearch(dlx, board, &budget))
+        return SOLVE_SOLVED;
+
+    return budget.exhausted ? SOLVE_EXHAUSTED : SOLVE_UNSOLVABLE;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Solves the array with Dancing Links. Returns true with the solution in the
+ array, or false, leaving the array unchanged, if the puzzle has no solution.
+
+**/
+/******************************************************************************/
+
+
+
+bool dlxSolve(Dlx &dlx, int arr[][SIDE])
+{
+    Board board;
+
+    if (!initBoard(board, arr) || !dlxSolve(dlx, board))
+        return false;
+
+    for (int cell = 0; cell < CELLS; cell++)
+        arr[rowOf(cell)][colOf(cell)] = board.value[cell];
+
+    return true;
+}// end bool dlxSolve(Dlx &dlx, int arr[][SIDE])
@@ -0,0 +1,44 @@
+/**
+  Name: dlx.h
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Dancing Links, Knuth's Algorithm X, as a second way to search.
+  The puzzle is an exact cover problem: each of the 729 candidate rows (a
+  number on a square) covers 4 of the 324 constraints (the square is filled,
+  the row, column and 3x3 grid each have the number once), and a solution is a
+  set of 81 candidate rows that covers every constraint exactly once.
+
+  All the nodes are allocated and linked once by initDlx(). Solving covers
+  the givens and searches, then uncovers everything on the way back out, so
+  the same Dlx is ready for the next puzzle without being rebuilt.
+*/
+
+#ifndef DLX_H
+#define DLX_H
+
+#include "board.h"
+#include "budget.h"
+
+const int DLX_COLUMNS = 4 * CELLS;                 // constraints
+const int DLX_ROWS = CELLS * SIDE;                 // candidate rows
+const int DLX_NODES = 1 + DLX_COLUMNS + 4 * DLX_ROWS;
+
+struct Dlx
+{
+    int left[DLX_NODES], right[DLX_NODES];
+    int up[DLX_NODES], down[DLX_NODES];
+    int column[DLX_NODES];          // column header of each node
+    int row[DLX_NODES];             // candidate row of each node
+    int size[1 + DLX_COLUMNS];      // nodes still in each column
+    int rowStart[DLX_ROWS];         // first node of each candidate row
+    int chosen[CELLS];              // candidate rows picked so far
+    int depth;                      // number of rows in chosen
+};
+
+void initDlx(Dlx &dlx);
+bool dlxSolve(Dlx &dlx, Board &board);
+SolveStatus dlxSolve(Dlx &dlx, Board &board, Budget &budget);
+bool dlxSolve(Dlx &dlx, int arr[][SIDE]);
+
+#endif // DLX_H
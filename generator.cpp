@@ -0,0 +1,442 @@
+/**
+  Name: generator.cpp
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Puzzle generator. See generator.h.
+*/
+
+#include <condition_variable>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "corpus.h"
+#include "generator.h"
+#include "pool.h"
+#include "search.h"
+
+using namespace std;
+
+const long GENERATE_CHUNK = 64;            // puzzles handed out at a time
+const int GENERATE_ATTEMPTS = 100;         // grids tried for a clue target
+const int GENERATE_AHEAD = 4;              // chunks per thread in flight
+
+
+
+/******************************************************************************/
+/**
+
+ Starts a random sequence. Two Randoms with the same seed give the same
+ numbers.
+
+**/
+/******************************************************************************/
+
+
+
+void seedRandom(Random &random, unsigned long long seed)
+{
+    random.state = seed;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Next 64 random bits (splitmix64).
+
+**/
+/******************************************************************************/
+
+
+
+unsigned long long nextRandom(Random &random)
+{
+    unsigned long long z = (random.state += 0x9E3779B97F4A7C15ULL);
+
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+
+    return z ^ (z >> 31);
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Random number from 0 to n - 1. The bias from taking the remainder is far too
+ small to matter for n this small.
+
+**/
+/******************************************************************************/
+
+
+
+int randomBelow(Random &random, int n)
+{
+    return int(nextRandom(random) % (unsigned long long)n);
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Fills the rest of the board the way depthFirst() does, but trying the
+ potential numbers of each square in random order. Returns false if the
+ board cannot be finished.
+
+**/
+/******************************************************************************/
+
+
+
+static bool fillRandom(Random &random, Board &board)
+{
+    Board guess = board;
+    int best = -1, fewest = SIDE + 1, digits[SIDE], count = 0;
+
+    if (!propagate(guess))
+        return false;
+
+    if (guess.left == 0)
+    {
+        board = guess;
+        return true;
+    }
+
+    for (int cell = 0; cell < CELLS; cell++)
+        if (guess.value[cell] == 0 && countDigits(guess.cand[cell]) < fewest)
+        {
+            best = cell;
+            fewest = countDigits(guess.cand[cell]);
+        }
+
+
+    /// Shuffles the potential numbers of the square
+    for (unsigned short mask = guess.cand[best]; mask; mask &= mask - 1)
+        digits[count++] = firstDigit(mask);
+
+    for (int i = count - 1; i > 0; i--)
+    {
+        int j = randomBelow(random, i + 1), swap = digits[i];
+
+        digits[i] = digits[j];
+        digits[j] = swap;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        Board next = guess;
+
+        placeDigit(next, best, digits[i]);
+
+        if (fillRandom(random, next))
+        {
+            board = next;
+            return true;
+        }
+    }
+
+    return false;
+}// end static bool fillRandom(Random &random, Board &board)
+
+
+
+/******************************************************************************/
+/**
+
+ Fills the board with a random solved grid.
+
+**/
+/******************************************************************************/
+
+
+
+void randomGrid(Random &random, Board &board)
+{
+    int empty[SIDE][SIDE] = {};
+
+    initBoard(board, empty);
+
+    fillRandom(random, board);
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Turns a symmetry name from the command line into a Symmetry. Returns false
+ if there is no symmetry by that name.
+
+**/
+/******************************************************************************/
+
+
+
+bool parseSymmetry(const char *name, Symmetry &symmetry)
+{
+    if (strcmp(name, "none") == 0)
+        symmetry = NO_SYMMETRY;
+    else if (strcmp(name, "rotational") == 0)
+        symmetry = ROTATIONAL;
+    else if (strcmp(name, "mirror") == 0)
+        symmetry = MIRROR;
+    else
+        return false;
+
+    return true;
+}
+
+
+
+/// The square that has to be emptied along with cell to keep the symmetry
+static int partnerOf(int cell, Symmetry symmetry)
+{
+    if (symmetry == ROTATIONAL)
+        return CELLS - 1 - cell;
+    else if (symmetry == MIRROR)
+        return rowOf(cell) * SIDE + SIDE - 1 - colOf(cell);
+
+    return cell;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Makes a random puzzle with a unique solution. Starts from a random solved
+ grid and tries taking each number off, together with its partner under
+ options.symmetry, in random order, putting them back if the puzzle would
+ then have more than one solution. Stops as soon as the puzzle is down to
+ options.clues; with options.clues 0 it goes on until nothing more can be
+ taken off. Returns false if the puzzle was left with more clues than asked
+ for.
+
+**/
+/******************************************************************************/
+
+
+
+bool generatePuzzle(Random &random, Board &puzzle,
+                    const GeneratorOptions &options)
+{
+    int arr[SIDE][SIDE], order[CELLS], clues = CELLS;
+    Board solution, test;
+
+    randomGrid(random, solution);
+
+    for (int cell = 0; cell < CELLS; cell++)
+    {
+        arr[rowOf(cell)][colOf(cell)] = solution.value[cell];
+        order[cell] = cell;
+    }
+
+    for (int i = CELLS - 1; i > 0; i--)
+    {
+        int j = randomBelow(random, i + 1), swap = order[i];
+
+        order[i] = order[j];
+        order[j] = swap;
+    }
+
+    for (int i = 0; i < CELLS && clues > options.clues; i++)
+    {
+        int cell = order[i], partner = partnerOf(cell, options.symmetry);
+        int digit = arr[rowOf(cell)][colOf(cell)];
+        int partnerDigit = arr[rowOf(partner)][colOf(partner)];
+
+        if (digit == 0)
+            continue;
+
+        arr[rowOf(cell)][colOf(cell)] = 0;
+        arr[rowOf(partner)][colOf(partner)] = 0;
+
+        initBoard(test, arr);
+
+        if (countSolutions(test, 2) != 1)
+        {
+            arr[rowOf(cell)][colOf(cell)] = digit;
+            arr[rowOf(partner)][colOf(partner)] = partnerDigit;
+        }
+        else
+            clues -= partner == cell ? 1 : 2;
+    }
+
+    initBoard(puzzle, arr);
+
+    return clues <= options.clues || options.clues == 0;
+}// end bool generatePuzzle(Random &random, Board &puzzle,
+//                         const GeneratorOptions &options)
+
+
+
+/******************************************************************************/
+/**
+
+ Makes a minimal random puzzle with a unique solution and no symmetry.
+
+**/
+/******************************************************************************/
+
+
+
+void generatePuzzle(Random &random, Board &puzzle)
+{
+    GeneratorOptions options = { 0, NO_SYMMETRY };
+
+    generatePuzzle(random, puzzle, options);
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Seed of puzzle number index of a batch. The batch seed and the index are
+ hashed together with splitmix64, so batches from nearby seeds have nothing
+ in common.
+
+**/
+/******************************************************************************/
+
+
+
+static unsigned long long puzzleSeed(unsigned long long seed, long index)
+{
+    Random mix;
+
+    seedRandom(mix, seed);
+    seedRandom(mix, nextRandom(mix) ^ (unsigned long long)index);
+
+    return nextRandom(mix);
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Makes count puzzles and writes them to out, one per line, using threads
+ threads (0 for one per core). Puzzle number i is made from its own Random,
+ seeded with puzzleSeed(seed, i), and tries up to GENERATE_ATTEMPTS grids to
+ reach options.clues. Returns how many puzzles missed the clue target and
+ were written with more clues.
+
+ Puzzles are made in chunks on the work stealing pool (pool.h), with up to
+ GENERATE_AHEAD chunks per thread in flight. A new chunk goes in as soon as
+ one is written, so no thread waits on the slowest chunk of a round.
+ Finished chunks wait in a reorder buffer until every chunk before them has
+ been written, so the puzzles come out in order.
+
+**/
+/******************************************************************************/
+
+
+
+long generateBatch(ostream &out, long count, unsigned long long seed,
+                   const GeneratorOptions &options, int threads)
+{
+    long missed = 0, chunks = (count + GENERATE_CHUNK - 1) / GENERATE_CHUNK;
+    long submitted = 0, written = 0;
+    vector<pair<long, string> > finished;
+    map<long, string> reorder;
+    WorkPool pool;
+    mutex doneLock;
+    condition_variable doneWake;
+
+    if (threads <= 0)
+        threads = defaultThreads();
+
+    startPool(pool, threads);
+
+
+    /// Hands chunk c to the pool
+    auto send = [&](long c)
+    {
+        submit(pool, [&, c](int)
+        {
+            long start = c * GENERATE_CHUNK;
+            long stop = min(count, start + GENERATE_CHUNK), misses = 0;
+            char line[CELLS];
+            string text;
+
+            for (long i = start; i < stop; i++)
+            {
+                Random random;
+                Board puzzle;
+                bool reached = false;
+
+                seedRandom(random, puzzleSeed(seed, i));
+
+                for (int a = 0; a < GENERATE_ATTEMPTS && !reached; a++)
+                    reached = generatePuzzle(random, puzzle, options);
+
+                if (!reached)
+                    misses++;
+
+                writeBoard(puzzle, line);
+                text.append(line, CELLS);
+                text += '\n';
+            }
+
+            lock_guard<mutex> guard(doneLock);
+            missed += misses;
+            finished.push_back(make_pair(c, string()));
+            finished.back().second.swap(text);
+            doneWake.notify_one();
+        });
+
+        submitted++;
+    };
+
+
+    /// Waits for chunks to finish and writes out every one that can be
+    auto drain = [&]()
+    {
+        vector<pair<long, string> > ready;
+
+        {
+            unique_lock<mutex> guard(doneLock);
+            doneWake.wait(guard, [&finished] { return !finished.empty(); });
+            ready.swap(finished);
+        }
+
+        for (size_t i = 0; i < ready.size(); i++)
+            reorder[ready[i].first].swap(ready[i].second);
+
+        while (!reorder.empty() && reorder.begin()->first == written)
+        {
+            const string &text = reorder.begin()->second;
+
+            out.write(text.data(), text.size());
+            reorder.erase(reorder.begin());
+            written++;
+        }
+    };
+
+
+    while (written < chunks)
+    {
+        while (submitted < chunks &&
+               submitted - written < GENERATE_AHEAD * threads)
+            send(submitted);
+
+        drain();
+    }
+
+    out.flush();
+
+    stopPool(pool);
+
+    return missed;
+}// end long generateBatch(ostream &out, long count, unsigned long long seed,
+//                         const GeneratorOptions &options, int threads)
@@ -0,0 +1,56 @@
+/**
+  Name: generator.h
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Puzzle generator. Fills an empty board at random, then takes
+  numbers back off in random order as long as the puzzle keeps a unique
+  solution. Everything random comes from a Random seeded by the caller, so
+  the same seed always gives the same puzzles on any machine.
+
+  Numbers can be taken off in symmetric pairs, so the finished puzzle looks
+  the same turned half way round (rotational) or flipped left to right
+  (mirror), and the generator can be told to keep going until the puzzle is
+  down to a target number of clues, starting over from a new grid if it gets
+  stuck above it.
+
+  generateBatch() makes many puzzles on every core at once. Each puzzle gets
+  its own Random, seeded from a hash of the batch seed and its position in
+  the batch, so a batch comes out the same whatever the number of threads.
+*/
+
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <ostream>
+
+#include "board.h"
+
+enum Symmetry { NO_SYMMETRY, ROTATIONAL, MIRROR };
+
+struct GeneratorOptions
+{
+    int clues;                      // stop at this many clues, 0 for minimal
+    Symmetry symmetry;
+};
+
+/// splitmix64 state. Small, fast and the same everywhere, unlike rand().
+struct Random
+{
+    unsigned long long state;
+};
+
+void seedRandom(Random &random, unsigned long long seed);
+unsigned long long nextRandom(Random &random);
+int randomBelow(Random &random, int n);
+
+bool parseSymmetry(const char *name, Symmetry &symmetry);
+
+void randomGrid(Random &random, Board &board);
+bool generatePuzzle(Random &random, Board &puzzle,
+                    const GeneratorOptions &options);
+void generatePuzzle(Random &random, Board &puzzle);
+long generateBatch(std::ostream &out, long count, unsigned long long seed,
+                   const GeneratorOptions &options, int threads);
+
+#endif // GENERATOR_H
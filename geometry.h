@@ -0,0 +1,109 @@
+/**
+  Name: geometry.h
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: The shape of a board of box order N: an N^2 x N^2 board made
+  of N x N grids. Geometry<N> has the sizes, and Lookup<N>::tables where
+  every square sits, the squares of every unit and the peers of every square,
+  worked out once by the compiler so that finding them is a table lookup.
+
+  Squares are numbered left to right, top to bottom, and grids the same way.
+  Units 0 to SIDE - 1 are the rows, then the columns, then the grids. The
+  9x9 board (board.h) and the other sizes (sized.h) share these tables.
+*/
+
+#ifndef GEOMETRY_H
+#define GEOMETRY_H
+
+#include <cstdint>
+#include <type_traits>
+
+template <int N>
+struct Geometry
+{
+    static const int BOX = N;                       // width of a grid
+    static const int SIDE = N * N;                  // squares in a row
+    static const int CELLS = SIDE * SIDE;           // squares on the board
+    static const int UNITS = 3 * SIDE;              // rows, columns, grids
+    static const int PEERS = 3 * SIDE - 2 * N - 1;  // squares sharing a unit
+
+    typedef typename std::conditional<(SIDE <= 16), uint16_t, uint32_t>::type
+        Mask;
+
+    /// Big enough to number every square
+    typedef typename std::conditional<(CELLS <= 256), uint8_t, uint16_t>::type
+        Index;
+
+    static const Mask ALL = Mask((1ULL << SIDE) - 1);
+};
+
+
+
+template <int N>
+struct Tables
+{
+    typedef Geometry<N> G;
+    typedef typename G::Index Index;
+
+    Index row[G::CELLS];
+    Index col[G::CELLS];
+    Index box[G::CELLS];
+    Index unit[G::UNITS][G::SIDE];          // the squares of each unit
+    Index peer[G::CELLS][G::PEERS];         // the peers of each square
+};
+
+
+
+template <int N>
+constexpr Tables<N> makeTables()
+{
+    typedef Geometry<N> G;
+    typedef typename G::Index Index;
+
+    Tables<N> tables = {};
+
+    for (int cell = 0; cell < G::CELLS; cell++)
+    {
+        int row = cell / G::SIDE, col = cell % G::SIDE;
+
+        tables.row[cell] = Index(row);
+        tables.col[cell] = Index(col);
+        tables.box[cell] = Index((row / N) * N + col / N);
+    }
+
+    for (int u = 0; u < G::SIDE; u++)
+        for (int i = 0; i < G::SIDE; i++)
+        {
+            tables.unit[u][i] = Index(u * G::SIDE + i);
+            tables.unit[G::SIDE + u][i] = Index(i * G::SIDE + u);
+            tables.unit[2 * G::SIDE + u][i] =
+                Index(((u / N) * N + i / N) * G::SIDE + (u % N) * N + i % N);
+        }
+
+    for (int cell = 0; cell < G::CELLS; cell++)
+    {
+        int count = 0;
+
+        for (int other = 0; other < G::CELLS; other++)
+            if (other != cell && (tables.row[other] == tables.row[cell] ||
+                                  tables.col[other] == tables.col[cell] ||
+                                  tables.box[other] == tables.box[cell]))
+                tables.peer[cell][count++] = Index(other);
+    }
+
+    return tables;
+}// end constexpr Tables<N> makeTables()
+
+
+
+template <int N>
+struct Lookup
+{
+    static constexpr Tables<N> tables = makeTables<N>();
+};
+
+template <int N>
+constexpr Tables<N> Lookup<N>::tables;
+
+#endif // GEOMETRY_H
@@ -0,0 +1,171 @@
+/**
+  Name: grader.cpp
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Difficulty grader. See grader.h.
+*/
+
+#include <cstdio>
+
+#include "grader.h"
+#include "logic.h"
+#include "search.h"
+
+using namespace std;
+
+/// Score of each technique, on the scale most graders use
+static const double SCORE[TECHNIQUES] =
+{
+    1.0,                            // naked single
+    1.5,                            // hidden single
+    2.6,                            // pointing
+    2.8,                            // claiming
+    3.0,                            // naked subset
+    3.4,                            // hidden subset
+    3.6,                            // x-wing
+    3.8,                            // swordfish
+    5.2,                            // jellyfish
+    10.0                            // guess
+};
+
+
+
+/******************************************************************************/
+/**
+
+ Grades the puzzle. solve() is run with only naked singles allowed, and each
+ time it gets stuck it is run again from where it stopped with the next
+ technique allowed as well, so a technique is only used once everything
+ easier has nothing left to find. The numbers placed by every run are
+ counted, but the eliminations of a run that got stuck are not, since the
+ next run starts again from the numbers placed and makes again whichever of
+ them it still needs.
+
+ If solve() is still stuck with every technique allowed, depthFirst() takes
+ over from there, within budget, and its guesses are counted instead. The
+ board is left solved, or as far as the search got if the budget ran out.
+ Returns SOLVE_UNSOLVABLE, with grade only partly filled in, if the puzzle
+ has no solution, and SOLVE_EXHAUSTED if the budget ran out.
+
+**/
+/******************************************************************************/
+
+
+
+SolveStatus gradePuzzle(const int puzzle[][SIDE], Grade &grade, Board &board,
+                        Budget &budget)
+{
+    int arr[SIDE][SIDE], left = 0;
+    SolveStatus status;
+
+    grade = Grade();
+    grade.hardest = NAKED_SINGLE;
+
+    for (int cell = 0; cell < CELLS; cell++)
+    {
+        arr[rowOf(cell)][colOf(cell)] = puzzle[rowOf(cell)][colOf(cell)];
+
+        if (arr[rowOf(cell)][colOf(cell)] == 0)
+            left++;
+    }
+
+    if (!initBoard(board, arr))
+        return SOLVE_UNSOLVABLE;
+
+    for (int level = NAKED_SINGLE; level < GUESS && left > 0; level++)
+    {
+        CountTrace trace;
+        bool solved = solve(arr, left, trace, Technique(level));
+
+        for (int t = NAKED_SINGLE; t <= level; t++)
+        {
+            if (solved || t == NAKED_SINGLE || t == HIDDEN_SINGLE)
+                grade.uses[t] += trace.uses[t];
+
+            if (grade.uses[t] > 0)
+                grade.hardest = Technique(t);
+        }
+    }
+
+
+    /// A board filled in with a clash had no solution to begin with
+    if (left == 0)
+    {
+        grade.score = SCORE[grade.hardest];
+
+        return initBoard(board, arr) ? SOLVE_SOLVED : SOLVE_UNSOLVABLE;
+    }
+
+
+    /// Logic alone was not enough
+    CountTrace trace;
+
+    grade.hardest = GUESS;
+    grade.score = SCORE[GUESS];
+
+    if (!initBoard(board, arr))
+        return SOLVE_UNSOLVABLE;
+
+    status = depthFirst(board, trace, budget);
+
+    grade.guesses = trace.uses[GUESS];
+    grade.depth = trace.depth;
+
+    return status;
+}// end SolveStatus gradePuzzle(const int puzzle[][SIDE], Grade &grade,
+//                              Board &board, Budget &budget)
+
+
+
+/******************************************************************************/
+/**
+
+ Adds a grade to out as one line without the newline: the score, the hardest
+ technique and then how many numbers each technique used placed or
+ eliminated, e.g.
+
+   2.8 claiming: naked single 24, hidden single 28, claiming 2
+
+ or, when the search had to finish the puzzle,
+
+   10.0 guess: 14 guesses, 3 deep, after naked single 5, hidden single 11
+
+**/
+/******************************************************************************/
+
+
+
+void writeGrade(const Grade &grade, string &out)
+{
+    char text[64];
+    bool first = true;
+
+    snprintf(text, sizeof text, "%.1f ", grade.score);
+
+    out += text;
+    out += techniqueName(grade.hardest);
+    out += ':';
+
+    if (grade.hardest == GUESS)
+        out += ' ' + to_string(grade.guesses) + " guesses, " +
+               to_string(grade.depth) + " deep, after";
+
+    for (int t = NAKED_SINGLE; t < GUESS; t++)
+    {
+        if (grade.uses[t] == 0)
+            continue;
+
+        if (!first)
+            out += ',';
+
+        out += ' ';
+        out += techniqueName(Technique(t));
+        out += ' ' + to_string(grade.uses[t]);
+
+        first = false;
+    }
+
+    if (first)
+        out += " nothing";
+}// end void writeGrade(const Grade &grade, string &out)
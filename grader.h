@@ -0,0 +1,40 @@
+/**
+  Name: grader.h
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Difficulty grader. Solves a puzzle with the easiest techniques
+  first, only bringing in a harder one (in the order of the Technique enum,
+  trace.h) once everything easier is stuck, and records the hardest technique
+  it needed, a score for it and how many numbers each technique placed or
+  eliminated. If logic alone is not enough, the rest is found by depth first
+  search and the grade is how many guesses that took and how deep they went.
+  The search is held to a budget (budget.h) like any other.
+
+  Nothing is drawn or printed, so whole collections can be graded in batch
+  mode (batch.h).
+*/
+
+#ifndef GRADER_H
+#define GRADER_H
+
+#include <string>
+
+#include "board.h"
+#include "budget.h"
+#include "trace.h"
+
+struct Grade
+{
+    Technique hardest;              // GUESS if logic alone was not enough
+    double score;                   // how hard hardest is, 1.0 to 10.0
+    long uses[TECHNIQUES];          // numbers placed or eliminated by each
+    long guesses;                   // guesses the search tried
+    int depth;                      // deepest of them
+};
+
+SolveStatus gradePuzzle(const int puzzle[][SIDE], Grade &grade, Board &board,
+                        Budget &budget);
+void writeGrade(const Grade &grade, std::string &out);
+
+#endif // GRADER_H
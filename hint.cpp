@@ -0,0 +1,552 @@
+/**
+  Name: hint.cpp
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Hints for a player. See hint.h.
+*/
+
+#include "hint.h"
+#include "logic.h"
+
+using namespace std;
+
+
+
+/******************************************************************************/
+/**
+
+ Starts a game on the puzzle in arr. Returns false if two of its numbers
+ clash.
+
+**/
+/******************************************************************************/
+
+
+
+bool startGame(Game &game, int arr[][SIDE])
+{
+    initTrail(game.trail);
+
+    return initBoard(game.board, arr);
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Puts the player's digit on a square, or clears the square for a digit of 0.
+ A number is placed through the trail so takeBack() can remove it. Returns
+ false, changing nothing, if the digit cannot go on the square, either
+ because a peer holds it or because a hint has taken it off.
+
+ Clearing a square is not the last move in general, so the board is worked
+ out again from the numbers left on it and nothing can be taken back after.
+
+**/
+/******************************************************************************/
+
+
+
+bool playMove(Game &game, int cell, int digit)
+{
+    int arr[SIDE][SIDE];
+
+    if (digit != 0)
+        return game.board.value[cell] == 0 &&
+               placeDigit(game.board, game.trail, cell, digit);
+
+    if (game.board.value[cell] == 0)
+        return true;
+
+    for (int other = 0; other < CELLS; other++)
+        arr[rowOf(other)][colOf(other)] =
+            other == cell ? 0 : game.board.value[other];
+
+    return startGame(game, arr);
+}// end bool playMove(Game &game, int cell, int digit)
+
+
+
+/******************************************************************************/
+/**
+
+ Takes back the last move or hint taken. Returns false if there is none.
+
+**/
+/******************************************************************************/
+
+
+
+bool takeBack(Game &game)
+{
+    if (game.trail.size == 0)
+        return false;
+
+    undoTrail(game.board, game.trail, game.trail.size - 1);
+
+    return true;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Makes the move a hint gives. Returns false if the board has changed since
+ and the move no longer applies.
+
+**/
+/******************************************************************************/
+
+
+
+bool applyHint(Game &game, const Hint &hint)
+{
+    if (hint.place)
+        return placeDigit(game.board, game.trail, hint.cell, hint.digit);
+
+    return removeDigit(game.board, game.trail, hint.cell, hint.digit);
+}
+
+
+
+/******************************************************************************/
+/**
+
+ The squares of a unit that can still hold digit, as a 9 bit mask, bit s
+ for unitCell(unit, s).
+
+**/
+/******************************************************************************/
+
+
+
+static unsigned short placesOf(const Board &board, int unit, int digit)
+{
+    unsigned short places = 0;
+
+    for (int s = 0; s < SIDE; s++)
+        if (board.cand[unitCell(unit, s)] & digitBit(digit))
+            places |= 1 << s;
+
+    return places;
+}
+
+
+
+/// Adds the squares of a unit picked out by a 9 bit mask to cells
+static void addUnitCells(Bitboard &cells, int unit, unsigned short mask)
+{
+    for (; mask != 0; mask &= mask - 1)
+        addCell(cells, unitCell(unit, firstDigit(mask) - 1));
+}
+
+
+
+/******************************************************************************/
+/**
+
+ The units of a square: its 3x3 grid, its row and its column, in the order
+ the hidden singles look at them.
+
+**/
+/******************************************************************************/
+
+
+
+static void unitsOf(int cell, int units[3])
+{
+    units[0] = 2 * SIDE + boxOf(cell);
+    units[1] = rowOf(cell);
+    units[2] = SIDE + colOf(cell);
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Finds the squares that show why the hint's step follows from board, the
+ board before it was taken, for each technique as listed in hint.h. Each
+ pattern is looked for again here rather than kept by the passes, which only
+ report what they changed; any pattern that gives the same step will do.
+
+**/
+/******************************************************************************/
+
+
+
+static void justify(const Board &board, Hint &hint)
+{
+    int cell = hint.cell, digit = hint.digit, units[3];
+    unsigned short bit = digitBit(digit);
+
+    hint.because.lo = 0;
+    hint.because.hi = 0;
+
+    unitsOf(cell, units);
+
+    switch (hint.technique)
+    {
+        case NAKED_SINGLE:
+        {
+            unsigned short seen = bit;
+
+            for (int i = 0; i < PEERS; i++)
+            {
+                int value = board.value[peerCell(cell, i)];
+
+                if (value != 0 && !(seen & digitBit(value)))
+                {
+                    seen |= digitBit(value);
+                    addCell(hint.because, peerCell(cell, i));
+                }
+            }
+
+            break;
+        }
+
+
+        /// The first unit where cell is the only place left, and for each
+        /// other empty square of it a peer that already holds digit, or the
+        /// square itself if a hint took digit off it
+        case HIDDEN_SINGLE:
+            for (int u = 0; u < 3; u++)
+            {
+                int unit = units[u];
+
+                if (countDigits(placesOf(board, unit, digit)) != 1)
+                    continue;
+
+                for (int s = 0; s < SIDE; s++)
+                {
+                    int other = unitCell(unit, s), blocker = other;
+
+                    if (other == cell || board.value[other] != 0)
+                        continue;
+
+                    for (int i = 0; i < PEERS; i++)
+                        if (board.value[peerCell(other, i)] == digit)
+                        {
+                            blocker = peerCell(other, i);
+                            break;
+                        }
+
+                    addCell(hint.because, blocker);
+                }
+
+                return;
+            }
+
+            break;
+
+
+        /// A 3x3 grid other than cell's whose places for digit all lie on
+        /// cell's row or column
+        case POINTING:
+            for (int b = 0; b < SIDE; b++)
+            {
+                unsigned short places = placesOf(board, 2 * SIDE + b, digit);
+                bool inRow = true, inCol = true;
+
+                if (b == boxOf(cell) || countDigits(places) < 2)
+                    continue;
+
+                for (int rest = places; rest != 0; rest &= rest - 1)
+                {
+                    int other = unitCell(2 * SIDE + b, firstDigit(rest) - 1);
+
+                    inRow = inRow && rowOf(other) == rowOf(cell);
+                    inCol = inCol && colOf(other) == colOf(cell);
+                }
+
+                if (inRow || inCol)
+                {
+                    addUnitCells(hint.because, 2 * SIDE + b, places);
+                    return;
+                }
+            }
+
+            break;
+
+
+        /// A row or column other than cell's whose places for digit all
+        /// lie in cell's 3x3 grid
+        case CLAIMING:
+            for (int line = 0; line < 2 * SIDE; line++)
+            {
+                unsigned short places = placesOf(board, line, digit);
+                bool inBox = true;
+
+                if (line == units[1] || line == units[2] ||
+                    countDigits(places) < 2)
+                    continue;
+
+                for (int rest = places; rest != 0; rest &= rest - 1)
+                    inBox = inBox &&
+                            boxOf(unitCell(line, firstDigit(rest) - 1)) ==
+                            boxOf(cell);
+
+                if (inBox)
+                {
+                    addUnitCells(hint.because, line, places);
+                    return;
+                }
+            }
+
+            break;
+
+
+        /// n other empty squares of one of cell's units with only n
+        /// potential numbers between them, digit among them
+        case NAKED_SUBSET:
+            for (int u = 0; u < 3; u++)
+            {
+                int unit = units[u];
+                unsigned short empty = 0;
+
+                for (int s = 0; s < SIDE; s++)
+                    if (board.value[unitCell(unit, s)] == 0 &&
+                        unitCell(unit, s) != cell)
+                        empty |= 1 << s;
+
+                for (int group = empty; group != 0;
+                     group = (group - 1) & empty)
+                {
+                    int size = countDigits(group);
+                    unsigned short mask = 0;
+
+                    if (size < 2 || size > 4)
+                        continue;
+
+                    for (int rest = group; rest != 0; rest &= rest - 1)
+                        mask |=
+                            board.cand[unitCell(unit, firstDigit(rest) - 1)];
+
+                    if (countDigits(mask) == size && (mask & bit))
+                    {
+                        addUnitCells(hint.because, unit, group);
+                        return;
+                    }
+                }
+            }
+
+            break;
+
+
+        /// n numbers other than digit that can only go on the same n
+        /// squares of one of cell's units, cell among them
+        case HIDDEN_SUBSET:
+            for (int u = 0; u < 3; u++)
+            {
+                int unit = units[u], at = 0;
+                unsigned short open = 0, places[SIDE];
+
+                for (int s = 0; s < SIDE; s++)
+                {
+                    if (unitCell(unit, s) == cell)
+                        at = s;
+
+                    open |= board.cand[unitCell(unit, s)];
+                }
+
+                for (int d = 1; d <= SIDE; d++)
+                    places[d - 1] = placesOf(board, unit, d);
+
+                open &= ~bit;
+
+                for (int group = open; group != 0; group = (group - 1) & open)
+                {
+                    int size = countDigits(group);
+                    unsigned short mask = 0;
+
+                    if (size < 2 || size > 4)
+                        continue;
+
+                    for (int rest = group; rest != 0; rest &= rest - 1)
+                        mask |= places[firstDigit(rest) - 1];
+
+                    if (countDigits(mask) == size && (mask & (1 << at)))
+                    {
+                        addUnitCells(hint.because, unit, mask);
+                        return;
+                    }
+                }
+            }
+
+            break;
+
+
+        /// n rows (or columns) other than cell's on which digit can only go
+        /// in the same n columns (or rows), cell's among them
+        case X_WING:
+        case SWORDFISH:
+        case JELLYFISH:
+        {
+            int size = hint.technique - X_WING + 2;
+
+            for (int across = 0; across < 2; across++)
+            {
+                int line = across == 0 ? rowOf(cell) : colOf(cell);
+                int cross = across == 0 ? colOf(cell) : rowOf(cell);
+                unsigned short lines[SIDE];
+                int bases = 0;
+
+                for (int m = 0; m < SIDE; m++)
+                {
+                    lines[m] = placesOf(board, across * SIDE + m, digit);
+
+                    if (m != line && lines[m] != 0 &&
+                        countDigits(lines[m]) <= size)
+                        bases |= 1 << m;
+                }
+
+                for (int base = bases; base != 0; base = (base - 1) & bases)
+                {
+                    unsigned short cover = 0;
+
+                    if (countDigits(base) != size)
+                        continue;
+
+                    for (int rest = base; rest != 0; rest &= rest - 1)
+                        cover |= lines[firstDigit(rest) - 1];
+
+                    if (countDigits(cover) != size || !(cover & (1 << cross)))
+                        continue;
+
+                    for (int rest = base; rest != 0; rest &= rest - 1)
+                        addUnitCells(hint.because,
+                                     across * SIDE + firstDigit(rest) - 1,
+                                     lines[firstDigit(rest) - 1]);
+
+                    return;
+                }
+            }
+
+            break;
+        }
+
+        default:
+            break;
+
+    }// end switch (hint.technique)
+
+}// end static void justify(const Board &board, Hint &hint)
+
+
+
+/******************************************************************************/
+/**
+
+ Finds the next step logic can take on the game's board and fills in hint.
+ Naked singles are read straight off the potential numbers. Otherwise the
+ passes of solve() are run on a copy of the board, easiest first: hidden
+ singles for every number, then locked candidates, then subsets, then fish,
+ stopping after the first pass that finds anything. Its first step is the
+ hint, and the rest of what the pass did is thrown away with the copy.
+
+ Returns false if the board is full, if an empty square has no potential
+ numbers left, or if logic cannot find a step.
+
+**/
+/******************************************************************************/
+
+
+
+bool nextHint(const Game &game, Hint &hint)
+{
+    static const Technique LOCKED[2] = { HIDDEN_SINGLE, CLAIMING };
+    const Board &board = game.board;
+    Board copy;
+    StepTrace trace;
+    bool gridPotential[SIDE][SIDE], change = false, elimination;
+    int arr[SIDE][SIDE], left = board.left;
+
+    if (left == 0)
+        return false;
+
+    for (int cell = 0; cell < CELLS && !trace.found; cell++)
+    {
+        if (board.value[cell] != 0)
+            continue;
+
+        if (board.cand[cell] == 0)
+            return false;
+
+        if (countDigits(board.cand[cell]) == 1)
+            trace.place(board, cell, firstDigit(board.cand[cell]),
+                        NAKED_SINGLE);
+    }
+
+    copy = board;
+
+    for (int cell = 0; cell < CELLS; cell++)
+        arr[rowOf(cell)][colOf(cell)] = copy.value[cell];
+
+
+    /// Hidden singles of every number first, then locked candidates, which
+    /// actualAddAndElimPotentialElim() looks for after hidden singles that
+    /// are by then known to find nothing
+    for (int pass = 0; pass < 2 && !trace.found; pass++)
+        for (int i = 1; i <= SIDE && !trace.found; i++)
+        {
+            for (int m = 0; m < SIDE; m++)
+            {
+                unsigned short row = rowCells(copy.digitCells[i - 1], m);
+
+                for (int n = 0; n < SIDE; n++)
+                    gridPotential[m][n] = (row >> n) & 1;
+            }
+
+            actualAddAndElimPotentialElim(arr, copy, gridPotential,
+                                          elimination, change, left, i, trace,
+                                          LOCKED[pass]);
+        }
+
+    if (!trace.found)
+        subsets(copy, change, trace, HIDDEN_SUBSET);
+
+    if (!trace.found)
+        fish(copy, change, trace, JELLYFISH);
+
+    if (!trace.found)
+        return false;
+
+    hint.technique = trace.technique;
+    hint.place = trace.placed;
+    hint.cell = trace.cell;
+    hint.digit = trace.digit;
+
+    justify(board, hint);
+
+    return true;
+}// end bool nextHint(const Game &game, Hint &hint)
+
+
+
+/******************************************************************************/
+/**
+
+ Adds a hint to out as one line without the newline: the step as TextTrace
+ (trace.h) writes it, then the squares that show why, e.g.
+
+   r3c5=7 hidden single: r1c4 r2c9 r5c6
+
+**/
+/******************************************************************************/
+
+
+
+void writeHint(const Hint &hint, string &out)
+{
+    out += 'r' + to_string(rowOf(hint.cell) + 1) + 'c' +
+           to_string(colOf(hint.cell) + 1) + (hint.place ? '=' : '-') +
+           to_string(hint.digit) + ' ' + techniqueName(hint.technique) + ':';
+
+    for (int cell = 0; cell < CELLS; cell++)
+        if (hasCell(hint.because, cell))
+            out += " r" + to_string(rowOf(cell) + 1) + 'c' +
+                   to_string(colOf(cell) + 1);
+}
@@ -0,0 +1,68 @@
+/**
+  Name: hint.h
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Hints for a player. nextHint() finds the easiest next step
+  logic can take on the player's board: the technique, the number placed on
+  a square or taken off it, and the squares that show why.
+
+  A game keeps the player's board with its potential numbers between hints,
+  so a hint does not start again from the puzzle. The player's moves and any
+  hints taken update it as they go, and the last of them can be taken back.
+  Clearing a square instead works out the potential numbers again from the
+  numbers left, and drops what earlier hints had taken off.
+
+  The step is found by the same passes solve() (logic.h) makes, one at a time
+  in the order of the Technique enum on a copy of the board, stopping after
+  the first pass that finds anything. Most hints are a naked or hidden single
+  and take a few microseconds; a board that needs a fish still takes well
+  under a millisecond.
+
+  The squares that show why are:
+
+    naked single      a filled peer for each of the other numbers
+    hidden single     for each other empty square of the row, column or 3x3
+                      grid, a filled peer holding the number, or the square
+                      itself if a hint took the number off it
+    pointing          the squares of the 3x3 grid that can hold the number
+    claiming          the squares of the row or column that can hold it
+    naked subset      the squares of the subset
+    hidden subset     the same
+    x-wing, swordfish the squares of the base rows or columns that can hold
+    and jellyfish     the number
+*/
+
+#ifndef HINT_H
+#define HINT_H
+
+#include <string>
+
+#include "board.h"
+#include "trace.h"
+
+struct Hint
+{
+    Technique technique;
+    bool place;                     // true to place digit, false to take it
+                                    // off the potential numbers of cell
+    int cell;
+    int digit;
+    Bitboard because;               // squares that show why
+};
+
+struct Game
+{
+    Board board;                    // the player's numbers, less whatever
+                                    // hints have taken off
+    Trail trail;                    // every move, so it can be taken back
+};
+
+bool startGame(Game &game, int arr[][SIDE]);
+bool playMove(Game &game, int cell, int digit);
+bool takeBack(Game &game);
+bool nextHint(const Game &game, Hint &hint);
+bool applyHint(Game &game, const Hint &hint);
+void writeHint(const Hint &hint, std::string &out);
+
+#endif // HINT_H
@@ -0,0 +1,1103 @@
+/**
+  Name: logic.cpp
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: The logic methods and brute force used by the Sudoku solver,
+  split out of main.cpp so the benchmark can link them too. See logic.h.
+*/
+
+#include <cstdlib>
+#include <iostream>
+#include <ctime>
+
+#include "board.h"
+#include "counters.h"
+#include "generator.h"
+#include "logic.h"
+
+using namespace std;
+
+
+
+/******************************************************************************/
+/**
+
+ Receives the array filled with the puzzle and attempts to solve it using
+ logic. If an answer to a square is discovered it is added to the array and
+ reported to trace. If the puzzle is solved, returns true. If the puzzle
+ cannot be solved using these logic methods, returns false.
+
+ Only the techniques up to hardest (trace.h) are used.
+
+**/
+/******************************************************************************/
+
+
+
+template <class Trace>
+bool solve(int arr[][9], int &leftToSolve, Trace &trace, Technique hardest)
+{
+    bool change, elimination, gridPotential[9][9];
+    Board board;
+    int cell, digit;
+    ThreadCounters *counters = stageCounters();
+    long started;
+
+
+    /// Works out the potential numbers of every square once. From here on
+    /// they are kept up to date as numbers are placed instead of rescanning
+    /// the row, column and 3x3 grid of every square on every pass.
+    initBoard(board, arr);
+
+    do
+    {
+        change = false;
+
+        started = startPass(counters);
+
+        for (int j = 0; j < 9; j++)
+        {
+            for (int k = 0; k < 9; k++)
+            {
+                cell = j * SIDE + k;
+
+                /// If there is only one potential number left, it goes on
+                /// the square
+                if (arr[j][k] == 0 && countDigits(board.cand[cell]) == 1)
+                {
+                    digit = firstDigit(board.cand[cell]);
+
+                    arr[j][k] = digit;
+
+                    placeDigit(board, cell, digit);
+
+                    change = true;
+
+                    leftToSolve--;
+
+                    trace.place(board, cell, digit, NAKED_SINGLE);
+
+                    addCount(counters, STAGE_NAKED_SINGLES, COUNT_PLACEMENTS);
+
+                }// end if (arr[j][k] == 0 && ...)
+
+            }//end for (int k = 0; k < 9; k++)
+
+        }// end for (int j = 0; j < 9; j++)
+
+        endPass(counters, STAGE_NAKED_SINGLES, started);
+
+
+
+        for (int i = 1; i <= 9 && hardest >= HIDDEN_SINGLE; i++)
+        {
+
+            /// The squares that can still hold i, read off its bitboard
+            for (int m = 0; m < 9; m++)
+            {
+                unsigned short row = rowCells(board.digitCells[i - 1], m);
+
+                for (int n = 0; n < 9; n++)
+                    gridPotential[m][n] = (row >> n) & 1;
+            }
+
+
+
+            do
+            {
+                elimination = false;
+
+                actualAddAndElimPotentialElim(arr, board, gridPotential,
+                                              elimination, change,
+                                              leftToSolve, i, trace, hardest);
+
+            }
+            while (elimination);
+
+        }// end for (int i = 1; i <= 9 && hardest >= HIDDEN_SINGLE; i++)
+
+        if (hardest >= HIDDEN_SINGLE)
+            addCount(counters, STAGE_HIDDEN_SINGLES, COUNT_PASSES);
+
+        if (hardest >= POINTING)
+            addCount(counters, STAGE_LOCKED_CANDIDATES, COUNT_PASSES);
+
+
+
+        /// Subsets cost the most, so they only get a turn once the singles
+        /// and locked candidates have nothing left to find
+        if (!change && hardest >= NAKED_SUBSET)
+        {
+            started = startPass(counters);
+
+            subsets(board, change, trace, hardest);
+
+            endPass(counters, STAGE_SUBSETS, started);
+        }
+
+        if (!change && hardest >= X_WING)
+        {
+            started = startPass(counters);
+
+            fish(board, change, trace, hardest);
+
+            endPass(counters, STAGE_FISH, started);
+        }
+
+    }
+    while (change);
+
+    return leftToSolve == 0;
+
+}// end bool solve(int arr[][9], int &leftToSolve, Trace &trace,
+//                 Technique hardest)
+
+
+
+/******************************************************************************/
+/**
+
+ Displays the puzzle on out.
+
+**/
+/******************************************************************************/
+
+
+
+void display(int arr[][9], ostream &out)
+{
+    out << "=========================" << endl;
+
+    for (int j = 0; j < 9; j++)
+    {
+        out << "~ ";
+        for (int k = 0; k < 9; k++)
+        {
+            if (arr[j][k] == 0)
+                out << " ";
+            else
+                out << arr[j][k];
+            if ((k % 3) != 2)
+                out << "|";
+            else if (k != 8 )
+                out << " ~ ";
+            else
+                out << " ~";
+        }// end for (int k = 0; k < 9; k++)
+
+        out << endl;
+
+        if ((j % 3) != 2)
+            out << "-------------------------" << endl;
+        else out << "=========================" << endl;
+
+    }// end for (int j = 0; j < 3; j++)
+
+
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Eliminates the column, row and 3x3 square the number occupies
+
+**/
+/******************************************************************************/
+
+
+
+void squareEliminator(bool gridPotential[][9], int j, int k)
+{
+    /// Eliminates both the column and row the number
+    /// occupies
+    for (int m = 0; m < 9; m++)
+    {
+        gridPotential[j][m] = false;
+        gridPotential[m][k] = false;
+    }
+
+    /// Eliminates the 3x3 grid the number occupies
+    for (int i = 0; i < 9; i++)
+    {
+        int cell = unitCell(2 * SIDE + boxOf(j * SIDE + k), i);
+
+        gridPotential[rowOf(cell)][colOf(cell)] = false;
+    }
+}
+
+/******************************************************************************/
+/**
+
+ If there is only one potential space a number can occupy within a 3x3 grid,
+ row or column, adds that number to the array and deletes that numbers row,
+ column and 3x3 grid from the list of potential squares. Then looks for
+ locked candidates: potential spaces of a 3x3 grid that all line up on a row
+ or column (pointing), and potential spaces of a row or column that all sit
+ in one 3x3 grid (claiming). Either way the number is eliminated from the
+ rest of the row, column or grid, on the board as well as in gridPotential.
+ All of it is reported to trace. Pointing and claiming are left out if
+ hardest comes before them. The time taken is counted (counters.h), but
+ not a pass, since this only goes over one number of the sweep solve()
+ makes.
+
+**/
+/******************************************************************************/
+
+template <class Trace>
+void actualAddAndElimPotentialElim(int arr[][9], Board &board,
+                                   bool gridPotential[][9],
+                                   bool &elimination, bool &change,
+                                   int &leftToSolve, int &i, Trace &trace,
+                                   Technique hardest)
+{
+    ThreadCounters *counters = stageCounters();
+    long started = startPass(counters);
+
+
+    /// If there is only one potential space a number can occupy within a
+    /// 3x3 grid, the number goes there
+    for (int b = 0; b < 9; b++)
+    {
+        int potentialSpaces = 0, space = 0;
+
+        for (int s = 0; s < 9; s++)
+        {
+            int cell = unitCell(2 * SIDE + b, s);
+
+            if (gridPotential[rowOf(cell)][colOf(cell)] == true)
+            {
+                potentialSpaces++;
+                space = cell;
+            }
+        }
+
+        if (potentialSpaces == 1)
+        {
+            int m = rowOf(space), n = colOf(space);
+
+            arr[m][n] = i;
+
+            placeDigit(board, space, i);
+
+            change = true;
+
+            leftToSolve--;
+
+            squareEliminator(gridPotential, m, n);
+
+            elimination = true;
+
+            trace.place(board, space, i, HIDDEN_SINGLE);
+
+            addCount(counters, STAGE_HIDDEN_SINGLES, COUNT_PLACEMENTS);
+
+        }// end if (potentialSpaces == 1)
+
+    }// end for (int b = 0; b < 9; b++)
+
+
+
+    /// If there is only one potential space a number can occupy within a
+    /// row or column, the number goes there just as it does for a 3x3 grid
+    for (int m = 0; m < 9; m++)
+    {
+        int rowSpaces = 0, colSpaces = 0, rowSpace = 0, colSpace = 0;
+
+        for (int n = 0; n < 9; n++)
+        {
+            if (gridPotential[m][n] == true)
+            {
+                rowSpaces++;
+                rowSpace = n;
+            }
+
+            if (gridPotential[n][m] == true)
+            {
+                colSpaces++;
+                colSpace = n;
+            }
+        }
+
+        if (rowSpaces == 1)
+        {
+            arr[m][rowSpace] = i;
+
+            placeDigit(board, m * SIDE + rowSpace, i);
+
+            change = true;
+
+            leftToSolve--;
+
+            squareEliminator(gridPotential, m, rowSpace);
+
+            elimination = true;
+
+            trace.place(board, m * SIDE + rowSpace, i, HIDDEN_SINGLE);
+
+            addCount(counters, STAGE_HIDDEN_SINGLES, COUNT_PLACEMENTS);
+        }
+
+        /// Placing in the row may have taken the column's only space
+        if (colSpaces == 1 && gridPotential[colSpace][m] == true)
+        {
+            arr[colSpace][m] = i;
+
+            placeDigit(board, colSpace * SIDE + m, i);
+
+            change = true;
+
+            leftToSolve--;
+
+            squareEliminator(gridPotential, colSpace, m);
+
+            elimination = true;
+
+            trace.place(board, colSpace * SIDE + m, i, HIDDEN_SINGLE);
+
+            addCount(counters, STAGE_HIDDEN_SINGLES, COUNT_PLACEMENTS);
+        }
+
+    }// end for (int m = 0; m < 9; m++)
+
+    addTime(counters, STAGE_HIDDEN_SINGLES, started);
+
+    if (hardest < POINTING)
+        return;
+
+    started = startPass(counters);
+
+
+
+    /// Takes i off a square that is still a potential space for it, both
+    /// here and on the board so the other numbers see it too
+    auto eliminate = [&](int m, int n, Technique technique)
+    {
+        if (gridPotential[m][n] == false)
+            return;
+
+        gridPotential[m][n] = false;
+
+        removeDigit(board, m * SIDE + n, i);
+
+        elimination = true;
+
+        change = true;
+
+        trace.eliminate(board, m * SIDE + n, i, technique);
+
+        addCount(counters, STAGE_LOCKED_CANDIDATES, COUNT_ELIMINATIONS);
+    };
+
+
+
+    /// Pointing: if the 2 or 3 potential spaces within a 3x3 grid all line
+    /// up on one row or column, i takes that row or column within the grid,
+    /// so it is eliminated from the rest of that row or column
+    for (int b = 0; b < 9; b++)
+    {
+        int spaces = 0, rows = 0, cols = 0;
+
+        for (int s = 0; s < 9; s++)
+        {
+            int cell = unitCell(2 * SIDE + b, s);
+
+            if (gridPotential[rowOf(cell)][colOf(cell)] == true)
+            {
+                spaces++;
+                rows |= 1 << rowOf(cell);
+                cols |= 1 << colOf(cell);
+            }
+        }
+
+        if (spaces < 2)
+            continue;
+
+        for (int n = 0; n < 9; n++)
+        {
+            if (countDigits(rows) == 1 &&
+                boxOf((firstDigit(rows) - 1) * SIDE + n) != b)
+                eliminate(firstDigit(rows) - 1, n, POINTING);
+
+            if (countDigits(cols) == 1 &&
+                boxOf(n * SIDE + firstDigit(cols) - 1) != b)
+                eliminate(n, firstDigit(cols) - 1, POINTING);
+        }
+
+    }// end for (int b = 0; b < 9; b++)
+
+
+
+    /// Claiming: if the 2 or 3 potential spaces within a row or column all
+    /// sit in one 3x3 grid, i takes that row or column within the grid, so
+    /// it is eliminated from the rest of that grid
+    for (int m = 0; m < 9 && hardest >= CLAIMING; m++)
+    {
+        int rowSpaces = 0, colSpaces = 0, rowBoxes = 0, colBoxes = 0;
+
+        for (int n = 0; n < 9; n++)
+        {
+            if (gridPotential[m][n] == true)
+            {
+                rowSpaces++;
+                rowBoxes |= 1 << boxOf(m * SIDE + n);
+            }
+
+            if (gridPotential[n][m] == true)
+            {
+                colSpaces++;
+                colBoxes |= 1 << boxOf(n * SIDE + m);
+            }
+        }
+
+        for (int s = 0; s < 9; s++)
+        {
+            int cell;
+
+            if (rowSpaces >= 2 && countDigits(rowBoxes) == 1)
+            {
+                cell = unitCell(2 * SIDE + firstDigit(rowBoxes) - 1, s);
+
+                if (rowOf(cell) != m)
+                    eliminate(rowOf(cell), colOf(cell), CLAIMING);
+            }
+
+            if (colSpaces >= 2 && countDigits(colBoxes) == 1)
+            {
+                cell = unitCell(2 * SIDE + firstDigit(colBoxes) - 1, s);
+
+                if (colOf(cell) != m)
+                    eliminate(rowOf(cell), colOf(cell), CLAIMING);
+            }
+        }
+
+    }// end for (int m = 0; m < 9 && hardest >= CLAIMING; m++)
+
+    addTime(counters, STAGE_LOCKED_CANDIDATES, started);
+
+}// end void actualAddAndElimPotentialElim(int arr[][9], Board &board,
+//                                        bool gridPotential[][9],
+//                                        bool &elimination, bool &change,
+//                                        int &leftToSolve, int &i,
+//                                        Trace &trace, Technique hardest)
+
+
+
+/******************************************************************************/
+/**
+
+ Looks for naked and hidden subsets of 2, 3 or 4 in every row, column and
+ 3x3 grid. If the potential numbers of n squares of a unit come to only n
+ numbers between them (naked), those numbers go on those squares, so they
+ are eliminated from the rest of the unit. If n numbers can only go on the
+ same n squares of a unit (hidden), those squares cannot hold anything else.
+ Sets change if anything was eliminated, and reports it to trace. Hidden
+ subsets are skipped if hardest is NAKED_SUBSET.
+
+ Squares and numbers are both 9 bit masks, so the subsets to try are the
+ submasks of the empty squares or of the numbers left, and the size of a
+ subset is a popcount.
+
+**/
+/******************************************************************************/
+
+
+
+template <class Trace>
+void subsets(Board &board, bool &change, Trace &trace, Technique hardest)
+{
+    int cells[9];
+    unsigned short places[9], empty, open;
+    ThreadCounters *counters = stageCounters();
+
+
+    /// Takes the numbers in mask off a square
+    auto takeOff = [&](int cell, unsigned short mask, Technique technique)
+    {
+        for (int d = 1; d <= 9; d++)
+            if (board.cand[cell] & mask & digitBit(d))
+            {
+                removeDigit(board, cell, d);
+
+                change = true;
+
+                trace.eliminate(board, cell, d, technique);
+
+                addCount(counters, STAGE_SUBSETS, COUNT_ELIMINATIONS);
+            }
+    };
+
+    for (int unit = 0; unit < UNITS; unit++)
+    {
+        empty = 0;
+        open = 0;
+
+        for (int d = 0; d < 9; d++)
+            places[d] = 0;
+
+
+        /// Which squares of the unit are empty, which numbers are still to
+        /// be placed, and where each of them can go
+        for (int s = 0; s < 9; s++)
+        {
+            cells[s] = unitCell(unit, s);
+
+            if (board.value[cells[s]] != 0)
+                continue;
+
+            empty |= 1 << s;
+            open |= board.cand[cells[s]];
+
+            for (int d = 0; d < 9; d++)
+                if (board.cand[cells[s]] & (1 << d))
+                    places[d] |= 1 << s;
+        }
+
+        /// Every set of empty squares as a naked subset
+        for (int group = empty; group != 0; group = (group - 1) & empty)
+        {
+            int size = countDigits(group);
+            unsigned short mask = 0;
+
+            if (size < 2 || size > 4 || size >= countDigits(empty))
+                continue;
+
+            for (int rest = group; rest != 0; rest &= rest - 1)
+                mask |= board.cand[cells[firstDigit(rest) - 1]];
+
+            if (countDigits(mask) == size)
+                for (int rest = empty & ~group; rest != 0; rest &= rest - 1)
+                    takeOff(cells[firstDigit(rest) - 1], mask, NAKED_SUBSET);
+        }
+
+
+        /// Every set of numbers still to be placed as a hidden subset
+        if (hardest < HIDDEN_SUBSET)
+            continue;
+
+        for (int group = open; group != 0; group = (group - 1) & open)
+        {
+            int size = countDigits(group);
+            unsigned short mask = 0;
+
+            if (size < 2 || size > 4 || size >= countDigits(open))
+                continue;
+
+            for (int rest = group; rest != 0; rest &= rest - 1)
+                mask |= places[firstDigit(rest) - 1];
+
+            if (countDigits(mask) == size)
+                for (int rest = mask; rest != 0; rest &= rest - 1)
+                    takeOff(cells[firstDigit(rest) - 1], ~group & ALL_DIGITS,
+                            HIDDEN_SUBSET);
+        }
+
+    }// end for (int unit = 0; unit < UNITS; unit++)
+
+}// end void subsets(Board &board, bool &change, Trace &trace,
+//                    Technique hardest)
+
+
+
+/******************************************************************************/
+/**
+
+ Looks for fish of every number: n rows on which the number can only go in
+ the same n columns (or n columns with only the same n rows). The number
+ has to take those n columns within those n rows, so it is eliminated from
+ the rest of the n columns (or rows). n is 2 for an X-Wing, 3 for a
+ Swordfish and 4 for a Jellyfish. Sets change if anything was eliminated,
+ and reports it to trace. Fish bigger than hardest are not looked for.
+
+ Rows come straight off the number's bitboard as 9 bit masks of columns,
+ and columns are those masks turned on their side.
+
+**/
+/******************************************************************************/
+
+
+
+template <class Trace>
+void fish(Board &board, bool &change, Trace &trace, Technique hardest)
+{
+    unsigned short lines[2][9];
+    ThreadCounters *counters = stageCounters();
+
+    for (int i = 1; i <= 9; i++)
+    {
+        for (int m = 0; m < 9; m++)
+        {
+            lines[0][m] = rowCells(board.digitCells[i - 1], m);
+            lines[1][m] = 0;
+        }
+
+        for (int m = 0; m < 9; m++)
+            for (int n = 0; n < 9; n++)
+                if (lines[0][m] & (1 << n))
+                    lines[1][n] |= 1 << m;
+
+
+        /// across 0 takes rows as the base and columns as the cover,
+        /// across 1 the other way round
+        for (int across = 0; across < 2; across++)
+        {
+            for (int size = 2; size <= 4 && X_WING + size - 2 <= hardest;
+                 size++)
+            {
+                int bases = 0;
+
+                for (int m = 0; m < 9; m++)
+                    if (lines[across][m] != 0 &&
+                        countDigits(lines[across][m]) <= size)
+                        bases |= 1 << m;
+
+                for (int base = bases; base != 0; base = (base - 1) & bases)
+                {
+                    unsigned short cover = 0;
+
+                    if (countDigits(base) != size)
+                        continue;
+
+                    for (int rest = base; rest != 0; rest &= rest - 1)
+                        cover |= lines[across][firstDigit(rest) - 1];
+
+                    if (countDigits(cover) != size)
+                        continue;
+
+                    for (int m = 0; m < 9; m++)
+                    {
+                        if (base & (1 << m))
+                            continue;
+
+                        for (int rest = cover; rest != 0; rest &= rest - 1)
+                        {
+                            int n = firstDigit(rest) - 1;
+                            int cell = across == 0 ? m * SIDE + n
+                                                   : n * SIDE + m;
+
+                            if (board.cand[cell] & digitBit(i))
+                            {
+                                removeDigit(board, cell, i);
+
+                                change = true;
+
+                                trace.eliminate(board, cell, i,
+                                                Technique(X_WING + size - 2));
+
+                                addCount(counters, STAGE_FISH,
+                                         COUNT_ELIMINATIONS);
+                            }
+                        }
+                    }
+
+                }// end for (int base = bases; base != 0; ...)
+
+            }// end for (int size = 2; size <= 4 && ...; size++)
+
+        }// end for (int across = 0; across < 2; across++)
+
+    }// end for (int i = 1; i <= 9; i++)
+
+}// end void fish(Board &board, bool &change, Trace &trace,
+//                 Technique hardest)
+
+
+
+/******************************************************************************/
+/**
+
+ Applies brute force to the array to solve it. Will solve any puzzle.
+
+ At each empty square, takes a randomly selected potential number of
+ that square and tests to see if it was already used in the row,
+ column or 3x3 grid. If it was not used, adds it to the square and goes
+ to the next empty square. If it was used, picks another randomly
+ selected potential number of that square and tests it. If all the
+ potential numbers of an empty square are already taken, a new brute
+ force attempt is started. Brute force is applied until the puzzle
+ is solved, then the solution is copied to the array. Each number tried
+ is reported to trace as a guess. The numbers are picked with a Random
+ started from seed.
+
+ With a budget every number placed and every new attempt is spent from it,
+ and once it runs out false is returned with the array unchanged. Without
+ one, a puzzle with no solution is only caught if some empty square has no
+ potential numbers at all; otherwise the attempts go on for ever.
+
+**/
+/******************************************************************************/
+
+
+
+template <class Trace>
+static bool randomRestarts(int arr[][9], Trace &trace, Budget *budget,
+                           unsigned long long seed)
+{
+    int numberOfPotentials[9][9], potentialNumbers[9][9][9], randomPotential,
+        arrCopy[9][9], numbersTriedCount, guessed = 0;
+    bool repeat, usedNumbers[9], taken, run;
+    Board board;
+    ThreadCounters *counters = stageCounters();
+    long started = startPass(counters);
+
+
+    /// Lists the potential numbers of every square and keeps track of how
+    /// many potential numbers are on each square. A clash, or an empty
+    /// square with none, means no attempt can ever succeed.
+    if (!initBoard(board, arr))
+    {
+        endPass(counters, STAGE_BRUTE_FORCE, started);
+        return false;
+    }
+
+    for (int m = 0; m < 9; m++)
+        for (int n = 0; n < 9; n++)
+        {
+            numberOfPotentials[m][n] = 0;
+
+            for (int i = 1; i <= 9; i++)
+                if (board.cand[m * SIDE + n] & digitBit(i))
+                {
+                    potentialNumbers[m][n][numberOfPotentials[m][n]] = i;
+
+                    numberOfPotentials[m][n]++;
+                }
+
+            if (arr[m][n] == 0 && numberOfPotentials[m][n] == 0)
+            {
+                endPass(counters, STAGE_BRUTE_FORCE, started);
+                return false;
+            }
+        }
+
+
+    /// Seed random number generator with the caller's seed. A Random of
+    /// its own rather than srand() keeps bruteForce() safe to run on
+    /// several threads at once.
+    Random random;
+
+    seedRandom(random, seed);
+
+
+
+    /// At each empty square, takes a randomly selected potential number of
+    /// that square and tests to see if it was already used in the row,
+    /// column or 3x3 grid. If it was not used, adds it to the square and goes
+    /// to the next empty square. If it was used, picks another randomly
+    /// selected potential number of that square and tests it. If all the
+    /// potential numbers of an empty square are already taken, a new brute
+    /// force attempt is started. Brute force is applied until the puzzle
+    /// is solved.
+    for (int j = 0; j < 9; j++)
+    {
+        for (int k = 0; k < 9; k++)
+        {
+
+            /// Initializes arrCopy to arr's state at the start of each brute
+            /// force attempt
+            if (j == 0 && k == 0)
+            {
+                for (int m = 0; m < 9; m++)
+                    for (int n = 0; n < 9; n++)
+                    {
+                        arrCopy[m][n] = arr[m][n];
+                    }
+
+                guessed = 0;
+
+            }// end if (j == 0 && k == 0)
+
+
+
+            if (arrCopy[j][k] == 0)
+            {
+                for (int m = 0; m < 9; m++)
+                {
+                    usedNumbers[m] = false;
+                }
+
+                repeat = false;
+
+                numbersTriedCount = 0;
+
+                do
+                {
+
+                    do
+                    {
+                        randomPotential = potentialNumbers[j][k]
+                            [randomBelow(random, numberOfPotentials[j][k])];
+
+                        if (usedNumbers[randomPotential - 1] == false)
+                        {
+                            repeat = false;
+
+                            run = true;
+
+                            usedNumbers[randomPotential - 1] = true;
+
+                            numbersTriedCount++;
+
+
+                        }// end if (usedNumbers[randomPotential - 1] == false)
+                        else
+                        {
+                            repeat = true;
+
+                            /// Ends this brute force attempt
+                            if (numbersTriedCount == numberOfPotentials[j][k])
+                            {
+                                addCount(counters, STAGE_BRUTE_FORCE,
+                                         COUNT_RESTARTS);
+
+                                if (budget != NULL && !spendRestart(*budget))
+                                {
+                                    endPass(counters, STAGE_BRUTE_FORCE,
+                                            started);
+                                    return false;
+                                }
+
+                                j = 0;
+
+                                k = -1;
+
+                                /// Breaks out of the do while loops
+
+                                repeat = false;
+
+                                run = false;
+
+                                taken = false;
+                            }
+                        }
+
+                    }
+                    while(repeat);
+
+
+                    if (run)
+                    {
+
+
+                        taken = false;
+
+                        /// Checks the row of the square to see if the number
+                        /// was already used
+                        for (int i = 0; i < 9; i++)
+                        {
+                            if (arrCopy[j][i] == randomPotential)
+                            {
+                                taken = true;
+                            }// end if (arrCopy[j][i] == randomPotential)
+
+                        }// end for (int i = 0; i < 9; i++)
+
+
+                        if (!taken)
+                        {
+
+                            /// Checks the column of the square to see if the
+                            /// number was already used
+                            for (int i = 0; i < 9; i++)
+                            {
+                                if (arrCopy[i][k] == randomPotential)
+                                {
+                                    taken = true;
+
+                                }// end if (arrCopy[i][k] == randomPotential)
+
+                            }// end for (int i = 0; i < 9; i++)
+
+
+
+                            if (!taken)
+                            {
+
+                                /// This section checks within the 3 x 3 grid
+                                /// of the square being tested to see if the
+                                /// number was already used
+
+                                for (int i = 0; i < 9; i++)
+                                {
+                                    int cell =
+                                        unitCell(2 * SIDE + boxOf(j * SIDE + k),
+                                                 i);
+
+                                    if (arrCopy[rowOf(cell)][colOf(cell)] ==
+                                        randomPotential)
+                                    {
+                                        taken = true;
+
+                                    }
+                                }
+
+
+
+                                /// If the number is not taken in the row,
+                                /// column, or 3x3 grid, it is placed on
+                                /// the square
+                                if (!taken)
+                                {
+                                    if (budget != NULL && !spendNode(*budget))
+                                    {
+                                        endPass(counters, STAGE_BRUTE_FORCE,
+                                                started);
+                                        return false;
+                                    }
+
+                                    arrCopy[j][k] = randomPotential;
+
+                                    trace.guess(j * SIDE + k, randomPotential,
+                                                ++guessed);
+
+                                    addCount(counters, STAGE_BRUTE_FORCE,
+                                             COUNT_GUESSES);
+                                }
+
+
+                            }// end if (!taken)
+
+                        }// end if (!taken)
+
+                    }// end if (run)
+
+                }
+                while (taken);
+
+            }// end if (arrCopy[j][k] == 0)
+
+        }// end for (int k = 0; k < 9; k++)
+    }// end for (int j = 0; j < 9; j++)
+
+    /// Copies the solution back to the array
+    for (int m = 0; m < 9; m++)
+        for (int n = 0; n < 9; n++)
+        {
+            arr[m][n] = arrCopy[m][n];
+        }
+
+    endPass(counters, STAGE_BRUTE_FORCE, started);
+
+    return true;
+
+}// end static bool randomRestarts(int arr[][9], Trace &trace,
+//                                  Budget *budget, unsigned long long seed)
+
+
+
+/******************************************************************************/
+/**
+
+ Brute force with no budget, seeded with the current time. Returns true
+ with the puzzle solved, or false if it is plain it has no solution.
+
+**/
+/******************************************************************************/
+
+
+
+template <class Trace>
+bool bruteForce(int arr[][9], Trace &trace)
+{
+    return randomRestarts(arr, trace, NULL, (unsigned long long)time(0));
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Brute force within budget, guessing from seed. Returns SOLVE_SOLVED with
+ the puzzle solved, or SOLVE_UNSOLVABLE or SOLVE_EXHAUSTED with the array
+ unchanged.
+
+**/
+/******************************************************************************/
+
+
+
+template <class Trace>
+SolveStatus bruteForce(int arr[][9], Trace &trace, Budget &budget,
+                       unsigned long long seed)
+{
+    if (randomRestarts(arr, trace, &budget, seed))
+        return SOLVE_SOLVED;
+
+    return budget.exhausted ? SOLVE_EXHAUSTED : SOLVE_UNSOLVABLE;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ solve() and bruteForce() with nothing traced.
+
+**/
+/******************************************************************************/
+
+
+
+bool solve(int arr[][9], int &leftToSolve)
+{
+    NullTrace trace;
+
+    return solve(arr, leftToSolve, trace);
+}
+
+
+
+bool bruteForce(int arr[][9])
+{
+    NullTrace trace;
+
+    return bruteForce(arr, trace);
+}
+
+
+
+bool bruteForce(int arr[][9], unsigned long long seed)
+{
+    NullTrace trace;
+
+    return randomRestarts(arr, trace, NULL, seed);
+}
+
+
+
+SolveStatus bruteForce(int arr[][9], Budget &budget, unsigned long long seed)
+{
+    NullTrace trace;
+
+    return bruteForce(arr, trace, budget, seed);
+}
+
+
+
+/// The sinks solve() and bruteForce() can be used with
+template bool solve(int [][9], int &, NullTrace &, Technique);
+template bool solve(int [][9], int &, BoardTrace &, Technique);
+template bool solve(int [][9], int &, TextTrace &, Technique);
+template bool solve(int [][9], int &, BinaryTrace &, Technique);
+template bool solve(int [][9], int &, CountTrace &, Technique);
+template bool bruteForce(int [][9], NullTrace &);
+template bool bruteForce(int [][9], BoardTrace &);
+template bool bruteForce(int [][9], TextTrace &);
+template bool bruteForce(int [][9], BinaryTrace &);
+template SolveStatus bruteForce(int [][9], NullTrace &, Budget &,
+                                 unsigned long long);
+template SolveStatus bruteForce(int [][9], BoardTrace &, Budget &,
+                                 unsigned long long);
+template SolveStatus bruteForce(int [][9], TextTrace &, Budget &,
+                                 unsigned long long);
+template SolveStatus bruteForce(int [][9], BinaryTrace &, Budget &,
+                                 unsigned long long);
+
+/// The passes of solve() the hints (hint.h) run one at a time
+template void actualAddAndElimPotentialElim(int [][9], Board &, bool [][9],
+                                            bool &, bool &, int &, int &,
+                                            StepTrace &, Technique);
+template void subsets(Board &, bool &, StepTrace &, Technique);
+template void fish(Board &, bool &, StepTrace &, Technique);
@@ -0,0 +1,69 @@
+/**
+  Name: logic.h
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: The original solving methods. solve() places what it can with
+  logic and returns false if that is not enough, bruteForce() finishes the
+  puzzle by guessing at random.
+
+  Both report what they do to a trace sink (trace.h). Without one nothing is
+  reported and nothing is printed.
+
+  solve() can be held to the techniques up to a hardest one, in the order of
+  the Technique enum, which is what the grader (grader.h) uses to find the
+  hardest technique a puzzle needs.
+
+  bruteForce() can be held to a budget (budget.h), so a puzzle with no
+  solution does not keep it going for ever. solve() needs none: every pass
+  places or eliminates something or is the last.
+
+  bruteForce() guesses with a Random (generator.h) started from the seed it
+  is given, so the same seed guesses the same way every run. The forms
+  without a seed take it from the clock.
+*/
+
+#ifndef LOGIC_H
+#define LOGIC_H
+
+#include <iostream>
+
+#include "board.h"
+#include "budget.h"
+#include "trace.h"
+
+template <class Trace>
+bool solve(int arr[][9], int &leftToSolve, Trace &trace,
+           Technique hardest = JELLYFISH);
+bool solve(int arr[][9], int &leftToSolve);
+
+void display(int arr[][9], std::ostream &out = std::cout);
+void squareEliminator(bool gridPotential[][9], int j, int k);
+
+template <class Trace>
+void actualAddAndElimPotentialElim(int arr[][9], Board &board,
+                                   bool gridPotential[][9],
+                                   bool &elimination, bool &change,
+                                   int &leftToSolve, int &i, Trace &trace,
+                                   Technique hardest = JELLYFISH);
+
+template <class Trace>
+void subsets(Board &board, bool &change, Trace &trace,
+             Technique hardest = JELLYFISH);
+
+template <class Trace>
+void fish(Board &board, bool &change, Trace &trace,
+          Technique hardest = JELLYFISH);
+
+template <class Trace>
+bool bruteForce(int arr[][9], Trace &trace);
+bool bruteForce(int arr[][9]);
+bool bruteForce(int arr[][9], unsigned long long seed);
+
+template <class Trace>
+SolveStatus bruteForce(int arr[][9], Trace &trace, Budget &budget,
+                       unsigned long long seed);
+SolveStatus bruteForce(int arr[][9], Budget &budget,
+                       unsigned long long seed);
+
+#endif // LOGIC_H
@@ -9,7 +9,68 @@
   that number.
 
   First it uses certain logic methods to try to solve the puzzle. If that fails,
-  it uses brute force to solve the puzzle.
+  it uses brute force to solve the puzzle. Run with "-e dfs" to use depth first
+  search (search.h) instead, which is deterministic and reports puzzles that
+  have no solution, or with "-e dlx" to use Dancing Links (dlx.h).
+
+  "-n nodes" gives up after that many guesses, "-R restarts" after that many
+  restarts of brute force or backtracks of a search, and "-w ms" after that
+  many milliseconds, showing how far it got (budget.h). They hold for "-b"
+  and "-d" too, for each puzzle.
+
+  Only the final board is displayed. Run with "-v board" to display the board
+  after every number placed, "-v text" for one line per step or "-v binary"
+  for a compact binary log (trace.h); "-l file" writes it to a file.
+
+  Run with "-b file" to solve a whole file of puzzles, one 81 character
+  puzzle per line, or "-b -" to read them from standard input (batch.h).
+  Puzzles are solved on every core; "-t n" sets the number of threads and
+  "-u" writes solutions as they are found, numbered, instead of in order.
+  "-e simd" solves 16 puzzles at a time with vector instructions (simd.h).
+  Lines of 16, 256 or 625 characters are solved as 4x4, 16x16 or 25x25
+  puzzles (sized.h).
+  "-c" writes the number of solutions of each puzzle instead (0, 1 or 2 for
+  more than one), or "-c n" to count up to n, and "-r" writes how hard each
+  one is: the hardest technique it needs, a score and how much each
+  technique did, or how much searching it took (grader.h). "-m n" caches
+  the solutions of up to n puzzles in canonical form (canonical.h), so
+  puzzles that are relabelled or rearranged copies of each other are solved
+  once. "-P json" or "-P prometheus" writes how many numbers each stage of
+  solving placed and eliminated, and how long it took, to standard error at
+  the end (counters.h).
+
+  "-p text packed" packs a file of puzzle lines into a binary file of 41
+  bytes a puzzle (packed.h), and "-x packed text" turns one back into lines.
+  "-b" reads packed files as well as text.
+
+  Run with "-d socket" to keep solving as a daemon, taking puzzles on a Unix
+  domain socket at that path, or "-d -" on standard input (server.h). "-e",
+  "-t", "-m" and "-P" work as they do with "-b", except that the counters are
+  sent in answer to a STATS command. client.cpp is a test client.
+
+  "-s seed" makes brute force guess the same way every run instead of
+  seeding from the clock.
+
+  Run with "-g n" to write n new puzzles with a unique solution, one per
+  line, made on every core (generator.h). "-s seed" makes the run
+  repeatable, "-k clues" stops taking numbers off at that many clues and
+  "-y rotational" or "-y mirror" keeps the puzzle symmetric.
+
+  The potential numbers of each square are kept in board.h. Compile all the
+  .cpp files together, for example:
+
+  g++ -O2 -pthread -o sudoku main.cpp logic.cpp board.cpp search.cpp \
+      dlx.cpp corpus.cpp batch.cpp pool.cpp trace.cpp simd.cpp sized.cpp \
+      generator.cpp grader.cpp packed.cpp canonical.cpp cache.cpp server.cpp \
+      counters.cpp budget.cpp hint.cpp
+
+  or build it, the benchmark and the test client with CMake, and run the
+  tests in tests/:
+
+  cmake -S . -B build && cmake --build build && ctest --test-dir build
+
+  benchmark.cpp is a separate program that times each way of solving; see the
+  top of that file for how to build and run it.
 
   Here is an example "data.txt" file, copy from after open quotation mark to
   before close quotation. Don't forget to add spaces so you have 9 sections
@@ -45,6 +106,19 @@
 #include <cctype>
 #include <fstream>
 #include <ctime>
+#include <string>
+
+#include "board.h"
+#include "logic.h"
+#include "search.h"
+#include "dlx.h"
+#include "batch.h"
+#include "budget.h"
+#include "counters.h"
+#include "generator.h"
+#include "packed.h"
+#include "server.h"
+#include "trace.h"
 
 using namespace std;
 
@@ -130,1735 +204,554 @@ bool fillBoard(int arr[][9], int &toSolve)
 /******************************************************************************/
 /**
 
- Receives the array filled with the puzzle and attempts to solve it using
- logic. If an answer to a square is discovered it is added to the array. If
- the puzzle is solved, returns true. If the puzzle cannot be solved using
- these logic methods, returns false.
+ Solves the puzzle read from data.txt: logic first, then the engine picked
+ if logic is not enough, held to budget. Brute force guesses from seed.
+ Every step is reported to trace and the result is displayed at the end.
 
 **/
 /******************************************************************************/
 
 
 
-bool solve(int arr[][9], int &leftToSolve)
+template <class Trace>
+void solvePuzzle(int board[][9], int &numToSolve, const string &engine,
+                 Trace &trace, Budget &budget, unsigned long long seed)
 {
-    bool change, potential[9], elimination, gridPotential[9][9];
-    int potentialLeft;
+    SolveStatus status = SOLVE_UNSOLVABLE;
+    const char *win;
 
-    void display(int [][9]);
-    void squareEliminator(bool [][9], int, int);
-    void actualAddAndElimPotentialElim(int arr[][9], bool gridPotential[][9],
-                                       bool &elimination, bool &change,
-                                       int &leftToSolve, int &i);
-
-
-
-    do
+    if (solve(board, numToSolve, trace))
     {
-        change = false;
-
-        for (int j = 0; j < 9; j++)
-        {
-            for (int k = 0; k < 9; k++)
-            {
-                if (arr[j][k] == 0)
-                {
-                    /// Before any numbers are eliminated, there are 9 potential
-                    /// numbers, the numbers 1-9
-                    for (int i = 0; i < 9; i++)
-                        potential[i] = true;
-
-                    potentialLeft = 9;
-
-
-                    /// Checks the row of the square to see which numbers where
-                    /// already used and therefore not a potential number for
-                    /// the square
-                    for (int i = 0; i < 9; i++)
-                    {
-                        if (arr[j][i] > 0)
-                        {
-                            potential[arr[j][i] - 1] = false;
-
-                            potentialLeft--;
-                        }// end if (arr[j][i] > 0)
-
-                    }// end for (int i = 0; i < 9; i++)
-
-
-
-                    /// Checks the column of the square to see which numbers
-                    /// where already used and therefore not a potential number
-                    /// for the square. It also checks to make sure the number
-                    /// has not already been eliminated.
-                    for (int i = 0; i < 9; i++)
-                    {
-                        if (arr[i][k] > 0)
-                            if (potential[arr[i][k] - 1] == true)
-                            {
-                                potential[arr[i][k] - 1] = false;
-
-                                potentialLeft--;
-                            }// end if (arr[i][k] > 0)
-
-                    }// end for (int i = 0; i < 9; i++)
-
-
-
-                    /// This section checks within the 3 x 3 grid of the square
-                    /// being tested to see which numbers are taken, and
-                    /// therefore not a potential number for the square.
-                    /// As before, it also checks to make sure the number
-                    /// has not already been eliminated.
-
-                    /// Top left 3x3 grid
-                    if (j <= 2 && k <=2)
-                    {
-                        for (int m = 0; m < 3; m++)
-                            for (int n = 0; n < 3; n++)
-                                if (arr[m][n] > 0)
-                                    if (potential[arr[m][n] - 1] == true)
-                                    {
-                                        potential[arr[m][n] - 1] = false;
-
-                                        potentialLeft--;
-                                    }
-                    }
-                    /// Top center 3x3 grid
-                    else if (j <= 2 && (k >= 3 && k <= 5))
-                    {
-                        for (int m = 0; m < 3; m++)
-                            for (int n = 3; n < 6; n++)
-                                if (arr[m][n] > 0)
-                                    if (potential[arr[m][n] - 1] == true)
-                                    {
-                                        potential[arr[m][n] - 1] = false;
-
-                                        potentialLeft--;
-                                    }
-                    }
-                    /// Top right 3x3 grid
-                    else if (j <= 2 && (k >= 6 && k <= 8))
-                    {
-                        for (int m = 0; m < 3; m++)
-                            for (int n = 6; n < 9; n++)
-                                if (arr[m][n] > 0)
-                                    if (potential[arr[m][n] - 1] == true)
-                                    {
-                                        potential[arr[m][n] - 1] = false;
-
-                                        potentialLeft--;
-                                    }
-                    }
-                    /// Middle left 3x3 grid
-                    else if ((j >= 3 && j <= 5) && k <=2)
-                    {
-                        for (int m = 3; m < 6; m++)
-                            for (int n = 0; n < 3; n++)
-                                if (arr[m][n] > 0)
-                                    if (potential[arr[m][n] - 1] == true)
-                                    {
-                                        potential[arr[m][n] - 1] = false;
-
-                                        potentialLeft--;
-                                    }
-                    }
-                    /// Middle center 3x3 grid
-                    else if ((j >= 3 && j <= 5) && (k >= 3 && k <= 5))
-                    {
-                        for (int m = 3; m < 6; m++)
-                            for (int n = 3; n < 6; n++)
-                                if (arr[m][n] > 0)
-                                    if (potential[arr[m][n] - 1] == true)
-                                    {
-                                        potential[arr[m][n] - 1] = false;
-
-                                        potentialLeft--;
-                                    }
-                    }
-                    /// Middle right 3x3 grid
-                    else if ((j >= 3 && j <= 5) && (k >= 6 && k <= 8))
-                    {
-                        for (int m = 3; m < 6; m++)
-                            for (int n = 6; n < 9; n++)
-                                if (arr[m][n] > 0)
-                                    if (potential[arr[m][n] - 1] == true)
-                                    {
-                                        potential[arr[m][n] - 1] = false;
-
-                                        potentialLeft--;
-                                    }
-                    }
-                    /// Bottom left 3x3 grid
-                    else if ((j >= 6 && j <= 8) && k <=2)
-                    {
-                        for (int m = 6; m < 9; m++)
-                            for (int n = 0; n < 3; n++)
-                                if (arr[m][n] > 0)
-                                    if (potential[arr[m][n] - 1] == true)
-                                    {
-                                        potential[arr[m][n] - 1] = false;
-
-                                        potentialLeft--;
-                                    }
-                    }
-                    /// Bottom center 3x3 grid
-                    else if ((j >= 6 && j <= 8) && (k >= 3 && k <= 5))
-                    {
-                        for (int m = 6; m < 9; m++)
-                            for (int n = 3; n < 6; n++)
-                                if (arr[m][n] > 0)
-                                    if (potential[arr[m][n] - 1] == true)
-                                    {
-                                        potential[arr[m][n] - 1] = false;
-
-                                        potentialLeft--;
-                                    }
-                    }
-                    /// Bottom right 3x3 grid
-                    else
-                    {
-                        for (int m = 6; m < 9; m++)
-                            for (int n = 6; n < 9; n++)
-                                if (arr[m][n] > 0)
-                                    if (potential[arr[m][n] - 1] == true)
-                                    {
-                                        potential[arr[m][n] - 1] = false;
-
-                                        potentialLeft--;
-                                    }
-                    }
-
-
-                    if (potentialLeft == 1)
-                    {
-                        for (int i = 0; i < 9; i++)
-                            if(potential[i] == true)
-                            {
-                                arr[j][k] = i + 1;
-
-                                change = true;
-
-                                leftToSolve--;
-
-                                display(arr);
-
-                                cout << leftToSolve << endl;
-                            }
-                    }
-
-
-                }// end if (arr[j][k] == 0)
-
-            }//end for (int k = 0; k < 9; k++)
-
-        }// end for (int j = 0; j < 9; j++)
-
-
-
-        for (int i = 1; i <= 9; i++)
-        {
-
-            /// Initialize all the squares to false if they are occupied
-            /// and true if they are empty
-            for (int m = 0; m < 9; m++)
-                for (int n = 0; n < 9; n++)
-                    if (arr[m][n] > 0)
-                    {
-                        gridPotential[m][n] = false;
-                    }
-                    else
-                    {
-                        gridPotential[m][n] = true;
-                    }
-
-
-
-
-            for (int j = 0; j < 9; j++)
-                for (int k = 0; k < 9; k++)
-                {
-
-                    if (arr[j][k] == i)
-                    {
-                        /// Eliminates the column, row and 3x3 grid the
-                        /// number occupies
-                        squareEliminator(gridPotential, j, k);
+        display(board);
+        cout << "Solved!" << endl;
+        return;
+    }
 
+    cout << "Could not solve!" << endl;
+    display(board);
+    cout << "Oh, no!" << endl;
 
+    startBudget(budget);
 
-                        /// This row has already been eliminated, start at the
-                        /// beginning of the next row. k is negative one
-                        /// because it will be incremented to 0 at the start of
-                        /// it's for loop. If j equals 8, incrementing j would
-                        /// cause the next set of test parameters to be
-                        /// 9 and 0 which is outside the range of the array
-                        if (j != 8)
-                        {
-                            k = -1;
-                            j++;
-                        }
-                    }// end if (arr[j][k] == i)
-                }
+    if (engine == "dfs" || engine == "dlx")
+    {
+        static Dlx dlx;
+        Board state;
 
+        win = engine == "dfs" ? "Depth first" : "Dancing links";
 
-            do
-            {
-                elimination = false;
+        if (engine == "dlx")
+            initDlx(dlx);
 
-                actualAddAndElimPotentialElim(arr, gridPotential, elimination,
-                                              change, leftToSolve, i);
+        if (initBoard(state, board))
+            status = engine == "dfs" ? depthFirst(state, trace, budget)
+                                     : dlxSolve(dlx, state, budget);
 
-            }
-            while (elimination);
-
-        }// end for (int i = 1; i <= 9; i++)
+        if (status != SOLVE_UNSOLVABLE)
+            for (int cell = 0; cell < CELLS; cell++)
+                board[rowOf(cell)][colOf(cell)] = state.value[cell];
+    }
+    else
+    {
+        win = "Brute force";
 
+        cout << endl;
+        cout << "Brute force being applied, please wait..." << endl << endl;
 
+        status = bruteForce(board, trace, budget, seed);
     }
-    while (change);
 
-    if (leftToSolve == 0)
+    if (status == SOLVE_SOLVED)
     {
-        cout << "Solved!" << endl;
-        return true;
+        display(board);
+        cout << win << " for the win!" << endl << endl;
     }
-    else
+    else if (status == SOLVE_EXHAUSTED)
     {
-        cout << "Could not solve!" << endl;
-        return false;
+        display(board);
+        cout << "Out of budget after " << budget.nodes << " guesses and "
+             << budget.restarts << " restarts!" << endl << endl;
     }
-
-}// end bool solve(int arr[][9], int &leftToSolve)
+    else
+        cout << "No solution!" << endl << endl;
+}// end void solvePuzzle(int board[][9], int &numToSolve,
+//                      const string &engine, Trace &trace, Budget &budget,
+//                      unsigned long long seed)
 
 
 
 /******************************************************************************/
 /**
 
- Displays the puzzle.
+ Solves every puzzle in fileName, or standard input if fileName is "-", and
+ writes the solutions to standard output. The file is mapped into memory
+ (corpus.h) and only read as a stream if it cannot be, such as a pipe.
+ threads is the number of puzzles solved at once, 0 for one per core. With
+ ordered false the solutions are written as they are found, each after its
+ line number. A countLimit above 0 writes the number of solutions of each
+ puzzle, up to countLimit, instead, and grade writes its grade (grader.h).
+ cacheSize above 0 caches that many solutions (cache.h). The totals, and
+ how often the cache was hit, go to standard error so they stay out of the
+ solutions, followed by the performance counters (counters.h) if
+ counterName is "json" or "prometheus". Every puzzle is held to limits
+ (budget.h). Returns 1, having solved nothing, if the file cannot be opened
+ or is a packed file whose header is bad or does not match its length.
 
 **/
 /******************************************************************************/
 
 
 
-void display(int arr[][9])
+int runBatchMode(const string &fileName, const string &engineName,
+                 int threads, bool ordered, int countLimit, bool grade,
+                 long cacheSize, const string &counterName,
+                 const Budget &limits)
 {
-    cout << "=========================" << endl;
-
-    for (int j = 0; j < 9; j++)
-    {
-        cout << "~ ";
-        for (int k = 0; k < 9; k++)
-        {
-            if (arr[j][k] == 0)
-                cout << " ";
-            else
-                cout << arr[j][k];
-            if ((k % 3) != 2)
-                cout << "|";
-            else if (k != 8 )
-                cout << " ~ ";
-            else
-                cout << " ~";
-        }// end for (int k = 0; k < 9; k++)
-
-        cout << endl;
-
-        if ((j % 3) != 2)
-            cout << "-------------------------" << endl;
-        else cout << "=========================" << endl;
-
-    }// end for (int j = 0; j < 3; j++)
-
-
-}
-
-
-
-/******************************************************************************/
-/**
-
- Eliminates the column, row and 3x3 square the number occupies
-
-**/
-/******************************************************************************/
+    BatchOptions options;
+    BatchTotals totals;
+    MappedFile mapped;
+    ifstream corpus;
+    CounterFormat counters = COUNTERS_OFF;
+    string counted;
 
-
-
-void squareEliminator(bool gridPotential[][9], int j, int k)
-{
-    /// Eliminates both the column and row the number
-    /// occupies
-    for (int m = 0; m < 9; m++)
+    if (!parseEngine(engineName, options.engine))
     {
-        gridPotential[j][m] = false;
-        gridPotential[m][k] = false;
+        cerr << "unknown batch engine: " << engineName << endl;
+        return 1;
     }
 
-    /// Eliminates the 3x3 grid the number occupies
-
-    /// Top left 3x3 grid
-    if (j <= 2 && k <=2)
-    {
-        for (int m = 0; m < 3; m++)
-            for (int n = 0; n < 3; n++)
-                gridPotential[m][n] = false;
-    }
-    /// Top center 3x3 grid
-    else if (j <= 2 && (k >= 3 && k <= 5))
-    {
-        for (int m = 0; m < 3; m++)
-            for (int n = 3; n < 6; n++)
-                gridPotential[m][n] = false;
-    }
-    /// Top right 3x3 grid
-    else if (j <= 2 && (k >= 6 && k <= 8))
-    {
-        for (int m = 0; m < 3; m++)
-            for (int n = 6; n < 9; n++)
-                gridPotential[m][n] = false;
-    }
-    /// Middle left 3x3 grid
-    else if ((j >= 3 && j <= 5) && k <=2)
-    {
-        for (int m = 3; m < 6; m++)
-            for (int n = 0; n < 3; n++)
-                gridPotential[m][n] = false;
-    }
-    /// Middle center 3x3 grid
-    else if ((j >= 3 && j <= 5) && (k >= 3 && k <= 5))
-    {
-        for (int m = 3; m < 6; m++)
-            for (int n = 3; n < 6; n++)
-                gridPotential[m][n] = false;
-    }
-    /// Middle right 3x3 grid
-    else if ((j >= 3 && j <= 5) && (k >= 6 && k <= 8))
-    {
-        for (int m = 3; m < 6; m++)
-            for (int n = 6; n < 9; n++)
-                gridPotential[m][n] = false;
-    }
-    /// Bottom left 3x3 grid
-    else if ((j >= 6 && j <= 8) && k <=2)
+    if (!counterName.empty() && !parseCounterFormat(counterName, counters))
     {
-        for (int m = 6; m < 9; m++)
-            for (int n = 0; n < 3; n++)
-                gridPotential[m][n] = false;
+        cerr << "unknown counter format: " << counterName << endl;
+        return 1;
     }
-    /// Bottom center 3x3 grid
-    else if ((j >= 6 && j <= 8) && (k >= 3 && k <= 5))
-    {
-        for (int m = 6; m < 9; m++)
-            for (int n = 3; n < 6; n++)
-                gridPotential[m][n] = false;
-    }
-    /// Bottom right 3x3 grid
-    else
-    {
-        for (int m = 6; m < 9; m++)
-            for (int n = 6; n < 9; n++)
-                gridPotential[m][n] = false;
-    }
-}
 
-/******************************************************************************/
-/**
+    if (counters != COUNTERS_OFF)
+        startCounters();
 
- If there is only one potential space a number can occupy within a 3x3 grid,
- adds that number to the array and deletes that numbers row, column and 3x3
- grid from the list of potential squares. If there are 2 potential spaces
- within a 3x3 grid and they line up on a row or column, that number can only
- occupy that row or column within that 3x3 grid, therefore that row or column
- is eliminated.
+    options.threads = threads;
+    options.ordered = ordered;
+    options.countLimit = countLimit;
+    options.grade = grade;
+    options.cacheSize = size_t(cacheSize);
+    options.limits = limits;
 
-**/
-/******************************************************************************/
+    ios::sync_with_stdio(false);
 
-void actualAddAndElimPotentialElim(int arr[][9], bool gridPotential[][9],
-                                   bool &elimination, bool &change,
-                                   int &leftToSolve, int &i)
-{
-    void display(int [][9]);
-    void squareEliminator(bool [][9], int, int);
-
-    int potentialSpaces = 0;
-
-
-    /// Top left 3x3 grid
-    for (int m = 0; m < 3; m++)
-        for (int n = 0; n < 3; n++)
-            if (gridPotential[m][n] == true)
-            {
-                potentialSpaces++;
-            }
-
-    if (potentialSpaces == 1)
+    if (fileName == "-")
+        totals = runBatch(cin, cout, options);
+    else if (mapFile(fileName.c_str(), mapped))
     {
-        for (int m = 0; m < 3; m++)
-            for (int n = 0; n < 3; n++)
-                if (gridPotential[m][n] == true)
-                {
-                    arr[m][n] = i;
-
-                    change = true;
-
-                    leftToSolve--;
-
-                    squareEliminator(gridPotential, m, n);
-
-                    elimination = true;
-
-                    display(arr);
-
-                    cout << leftToSolve << endl;
+        totals = runBatch(mapped, cout, options);
 
-                }
-
-    }// end if (potentialSpaces == 1)
-    else if (potentialSpaces == 2)
+        unmapFile(mapped);
+    }
+    else
     {
-        potentialSpaces = 0;
+        corpus.open(fileName.c_str());
 
-        /// If the 2 potential spaces line up in a row within a
-        /// 3x3 grid, that row is eliminated because it is already
-        /// taken by the number, i, in that 3x3 grid
-        for (int m = 0; m < 3; m++)
+        if (!corpus.is_open())
         {
-            for (int n = 0; n < 3; n++)
-            {
-                if (gridPotential[m][n] == true)
-                {
-                    potentialSpaces++;
-
-                    if (potentialSpaces == 2)
-                    {
-                        for (int j = 0; j < 9; j++)
-                        {
-                            gridPotential[m][j] = false;
-
-                            elimination = true;
-                        }// end for (int j = 0; j < 9; j++)
-                    }// end if (potentialSpaces == 2)
-                }// end if (gridPotential[m][n] == true)
-            }
-
-            potentialSpaces = 0;
+            cerr << "ERROR: unable to open " << fileName << endl;
+            return 1;
         }
 
+        totals = runBatch(corpus, cout, options);
+    }
 
+    if (totals.unreadable)
+        return 1;
 
-        /// If the 2 potential spaces line up in a column within a
-        /// 3x3 grid, that column is eliminated because it is
-        /// already taken by the number, i, in that 3x3 grid
-        for (int n = 0; n < 3; n++)
-        {
-            for (int m = 0; m < 3; m++)
-            {
-                if (gridPotential[m][n] == true)
-                {
-                    potentialSpaces++;
-
-                    if (potentialSpaces == 2)
-                    {
-                        for (int j = 0; j < 9; j++)
-                        {
-                            gridPotential[j][n] = false;
-
-                            elimination = true;
-                        }// end for (int j = 0; j < 9; j++)
-                    }// end if (potentialSpaces == 2)
-                }// end if (gridPotential[m][n] == true)
-            }
-
-            potentialSpaces = 0;
-        }
-
-    }// end else if (potentialSpaces == 2)
-
+    cerr << totals.puzzles << " puzzles, " << totals.solved << " solved, "
+         << totals.unsolvable << " with no solution, " << totals.malformed
+         << " lines skipped";
 
+    if (grade)
+        cerr << ", " << totals.searched << " needed a search";
 
-    potentialSpaces = 0;
+    if (totals.exhausted > 0)
+        cerr << ", " << totals.exhausted << " out of budget";
 
+    cerr << endl;
 
+    if (totals.cacheHits + totals.cacheMisses > 0)
+        cerr << "cache: " << totals.cacheHits << " hits, "
+             << totals.cacheMisses << " misses, "
+             << 100 * totals.cacheHits / (totals.cacheHits + totals.cacheMisses)
+             << "% hit rate" << endl;
 
-    /// Top center 3x3 grid
-    for (int m = 0; m < 3; m++)
-        for (int n = 3; n < 6; n++)
-            if (gridPotential[m][n] == true)
-            {
-                potentialSpaces++;
-            }
-
-    if (potentialSpaces == 1)
+    if (counters != COUNTERS_OFF)
     {
-        for (int m = 0; m < 3; m++)
-            for (int n = 3; n < 6; n++)
-                if (gridPotential[m][n] == true)
-                {
-                    arr[m][n] = i;
-
-                    change = true;
-
-                    leftToSolve--;
+        writeCounters(counters, counted);
 
-                    squareEliminator(gridPotential, m, n);
+        cerr << counted;
 
-                    elimination = true;
+        if (counters == COUNTERS_JSON)
+            cerr << endl;
+    }
 
-                    display(arr);
+    return 0;
+}// end int runBatchMode(const string &fileName, const string &engineName,
+//                       int threads, bool ordered, int countLimit,
+//                       bool grade, long cacheSize,
+//                       const string &counterName, const Budget &limits)
 
-                    cout << leftToSolve << endl;
 
-                }
 
-    }// end if (potentialSpaces == 1)
-    else if (potentialSpaces == 2)
-    {
-        potentialSpaces = 0;
+/******************************************************************************/
+/**
 
-        /// If the 2 potential spaces line up in a row within a
-        /// 3x3 grid, that row is eliminated because it is already
-        /// taken by the number, i, in that 3x3 grid
-        for (int m = 0; m < 3; m++)
-        {
-            for (int n = 3; n < 6; n++)
-            {
-                if (gridPotential[m][n] == true)
-                {
-                    potentialSpaces++;
-
-                    if (potentialSpaces == 2)
-                    {
-                        for (int j = 0; j < 9; j++)
-                        {
-                            gridPotential[m][j] = false;
-
-                            elimination = true;
-                        }// end for (int j = 0; j < 9; j++)
-                    }// end if (potentialSpaces == 2)
-                }// end if (gridPotential[m][n] == true)
-            }
+ Writes count new puzzles to standard output, made from seed on threads
+ threads (0 for one per core), with clues and symmetry as given. How many
+ puzzles were made, and how many missed the clue target, go to standard
+ error.
 
-            potentialSpaces = 0;
-        }
+**/
+/******************************************************************************/
 
 
 
-        /// If the 2 potential spaces line up in a column within a
-        /// 3x3 grid, that column is eliminated because it is
-        /// already taken by the number, i, in that 3x3 grid
-        for (int n = 3; n < 6; n++)
-        {
-            for (int m = 0; m < 3; m++)
-            {
-                if (gridPotential[m][n] == true)
-                {
-                    potentialSpaces++;
-
-                    if (potentialSpaces == 2)
-                    {
-                        for (int j = 0; j < 9; j++)
-                        {
-                            gridPotential[j][n] = false;
-
-                            elimination = true;
-                        }// end for (int j = 0; j < 9; j++)
-                    }// end if (potentialSpaces == 2)
-                }// end if (gridPotential[m][n] == true)
-            }
+int runGenerateMode(long count, unsigned long long seed, int clues,
+                    const string &symmetry, int threads)
+{
+    GeneratorOptions options;
+    long missed;
 
-            potentialSpaces = 0;
-        }
+    if (!parseSymmetry(symmetry.c_str(), options.symmetry))
+    {
+        cerr << "unknown symmetry: " << symmetry << endl;
+        return 1;
+    }
 
-    }// end else if (potentialSpaces == 2)
+    options.clues = clues;
 
+    ios::sync_with_stdio(false);
 
+    missed = generateBatch(cout, count, seed, options, threads);
 
-    potentialSpaces = 0;
+    cerr << count << " puzzles";
 
+    if (clues > 0)
+        cerr << ", " << missed << " with more than " << clues << " clues";
 
+    cerr << endl;
 
-    /// Top right 3x3 grid
-    for (int m = 0; m < 3; m++)
-        for (int n = 6; n < 9; n++)
-            if (gridPotential[m][n] == true)
-            {
-                potentialSpaces++;
-            }
+    return 0;
+}// end int runGenerateMode(long count, unsigned long long seed, int clues,
+//                          const string &symmetry, int threads)
 
-    if (potentialSpaces == 1)
-    {
-        for (int m = 0; m < 3; m++)
-            for (int n = 6; n < 9; n++)
-                if (gridPotential[m][n] == true)
-                {
-                    arr[m][n] = i;
 
-                    change = true;
 
-                    leftToSolve--;
+/******************************************************************************/
+/**
 
-                    squareEliminator(gridPotential, m, n);
+ Packs the puzzle lines of inName, or standard input if it is "-", into the
+ packed file outName, or with pack false turns the packed file inName back
+ into lines of text in outName, or on standard output if it is "-". How many
+ puzzles were converted goes to standard error.
 
-                    elimination = true;
+**/
+/******************************************************************************/
 
-                    display(arr);
 
-                    cout << leftToSolve << endl;
 
-                }
+int runConvertMode(bool pack, const string &inName, const string &outName)
+{
+    ifstream text;
+    ofstream out;
+    MappedFile mapped;
+    string error;
+    long long count;
+    long skipped = 0;
 
-    }// end if (potentialSpaces == 1)
-    else if (potentialSpaces == 2)
+    if (pack)
     {
-        potentialSpaces = 0;
-
-        /// If the 2 potential spaces line up in a row within a
-        /// 3x3 grid, that row is eliminated because it is already
-        /// taken by the number, i, in that 3x3 grid
-        for (int m = 0; m < 3; m++)
+        if (inName != "-")
         {
-            for (int n = 6; n < 9; n++)
+            text.open(inName.c_str());
+
+            if (!text.is_open())
             {
-                if (gridPotential[m][n] == true)
-                {
-                    potentialSpaces++;
-
-                    if (potentialSpaces == 2)
-                    {
-                        for (int j = 0; j < 9; j++)
-                        {
-                            gridPotential[m][j] = false;
-
-                            elimination = true;
-                        }// end for (int j = 0; j < 9; j++)
-                    }// end if (potentialSpaces == 2)
-                }// end if (gridPotential[m][n] == true)
+                cerr << "ERROR: unable to open " << inName << endl;
+                return 1;
             }
-
-            potentialSpaces = 0;
         }
 
+        out.open(outName.c_str(), ios::binary);
 
-
-        /// If the 2 potential spaces line up in a column within a
-        /// 3x3 grid, that column is eliminated because it is
-        /// already taken by the number, i, in that 3x3 grid
-        for (int n = 6; n < 9; n++)
+        if (!out.is_open())
         {
-            for (int m = 0; m < 3; m++)
-            {
-                if (gridPotential[m][n] == true)
-                {
-                    potentialSpaces++;
-
-                    if (potentialSpaces == 2)
-                    {
-                        for (int j = 0; j < 9; j++)
-                        {
-                            gridPotential[j][n] = false;
-
-                            elimination = true;
-                        }// end for (int j = 0; j < 9; j++)
-                    }// end if (potentialSpaces == 2)
-                }// end if (gridPotential[m][n] == true)
-            }
-
-            potentialSpaces = 0;
+            cerr << "ERROR: unable to open " << outName << endl;
+            return 1;
         }
 
-    }// end else if (potentialSpaces == 2)
-
-
-
-    potentialSpaces = 0;
-
+        count = packText(inName == "-" ? cin : text, out, skipped);
 
+        cerr << count << " puzzles packed, " << skipped << " lines skipped"
+             << endl;
 
-    /// Middle left 3x3 grid
-    for (int m = 3; m < 6; m++)
-        for (int n = 0; n < 3; n++)
-            if (gridPotential[m][n] == true)
-            {
-                potentialSpaces++;
-            }
+        return 0;
+    }// end if (pack)
 
-    if (potentialSpaces == 1)
+    if (!mapFile(inName.c_str(), mapped))
     {
-        for (int m = 3; m < 6; m++)
-            for (int n = 0; n < 3; n++)
-                if (gridPotential[m][n] == true)
-                {
-                    arr[m][n] = i;
-
-                    change = true;
-
-                    leftToSolve--;
-
-                    squareEliminator(gridPotential, m, n);
-
-                    elimination = true;
-
-                    display(arr);
-
-                    cout << leftToSolve << endl;
-
-                }
+        cerr << "ERROR: unable to map " << inName << endl;
+        return 1;
+    }
 
-    }// end if (potentialSpaces == 1)
-    else if (potentialSpaces == 2)
+    if (outName != "-")
     {
-        potentialSpaces = 0;
+        out.open(outName.c_str());
 
-        /// If the 2 potential spaces line up in a row within a
-        /// 3x3 grid, that row is eliminated because it is already
-        /// taken by the number, i, in that 3x3 grid
-        for (int m = 3; m < 6; m++)
+        if (!out.is_open())
         {
-            for (int n = 0; n < 3; n++)
-            {
-                if (gridPotential[m][n] == true)
-                {
-                    potentialSpaces++;
-
-                    if (potentialSpaces == 2)
-                    {
-                        for (int j = 0; j < 9; j++)
-                        {
-                            gridPotential[m][j] = false;
-
-                            elimination = true;
-                        }// end for (int j = 0; j < 9; j++)
-                    }// end if (potentialSpaces == 2)
-                }// end if (gridPotential[m][n] == true)
-            }
-
-            potentialSpaces = 0;
+            cerr << "ERROR: unable to open " << outName << endl;
+            unmapFile(mapped);
+            return 1;
         }
+    }
 
+    ios::sync_with_stdio(false);
 
+    count = unpackText(mapped.data, mapped.size, outName == "-" ? cout : out,
+                       error);
 
-        /// If the 2 potential spaces line up in a column within a
-        /// 3x3 grid, that column is eliminated because it is
-        /// already taken by the number, i, in that 3x3 grid
-        for (int n = 0; n < 3; n++)
-        {
-            for (int m = 3; m < 6; m++)
-            {
-                if (gridPotential[m][n] == true)
-                {
-                    potentialSpaces++;
-
-                    if (potentialSpaces == 2)
-                    {
-                        for (int j = 0; j < 9; j++)
-                        {
-                            gridPotential[j][n] = false;
-
-                            elimination = true;
-                        }// end for (int j = 0; j < 9; j++)
-                    }// end if (potentialSpaces == 2)
-                }// end if (gridPotential[m][n] == true)
-            }
-
-            potentialSpaces = 0;
-        }
-
-    }// end else if (potentialSpaces == 2)
-
-
-
-    potentialSpaces = 0;
-
-
-
-    /// Middle center 3x3 grid
-    for (int m = 3; m < 6; m++)
-        for (int n = 3; n < 6; n++)
-            if (gridPotential[m][n] == true)
-            {
-                potentialSpaces++;
-            }
-
-    if (potentialSpaces == 1)
-    {
-        for (int m = 3; m < 6; m++)
-            for (int n = 3; n < 6; n++)
-                if (gridPotential[m][n] == true)
-                {
-                    arr[m][n] = i;
-
-                    change = true;
-
-                    leftToSolve--;
-
-                    squareEliminator(gridPotential, m, n);
-
-                    elimination = true;
-
-                    display(arr);
-
-                    cout << leftToSolve << endl;
-
-                }
-
-    }// end if (potentialSpaces == 1)
-    else if (potentialSpaces == 2)
+    if (count < 0)
     {
-        potentialSpaces = 0;
-
-        /// If the 2 potential spaces line up in a row within a
-        /// 3x3 grid, that row is eliminated because it is already
-        /// taken by the number, i, in that 3x3 grid
-        for (int m = 3; m < 6; m++)
-        {
-            for (int n = 3; n < 6; n++)
-            {
-                if (gridPotential[m][n] == true)
-                {
-                    potentialSpaces++;
-
-                    if (potentialSpaces == 2)
-                    {
-                        for (int j = 0; j < 9; j++)
-                        {
-                            gridPotential[m][j] = false;
-
-                            elimination = true;
-                        }// end for (int j = 0; j < 9; j++)
-                    }// end if (potentialSpaces == 2)
-                }// end if (gridPotential[m][n] == true)
-            }
-
-            potentialSpaces = 0;
-        }
+        cerr << inName << ": " << error << endl;
+        unmapFile(mapped);
+        return 1;
+    }
 
+    cerr << count << " puzzles unpacked" << endl;
 
+    unmapFile(mapped);
 
-        /// If the 2 potential spaces line up in a column within a
-        /// 3x3 grid, that column is eliminated because it is
-        /// already taken by the number, i, in that 3x3 grid
-        for (int n = 3; n < 6; n++)
-        {
-            for (int m = 3; m < 6; m++)
-            {
-                if (gridPotential[m][n] == true)
-                {
-                    potentialSpaces++;
-
-                    if (potentialSpaces == 2)
-                    {
-                        for (int j = 0; j < 9; j++)
-                        {
-                            gridPotential[j][n] = false;
-
-                            elimination = true;
-                        }// end for (int j = 0; j < 9; j++)
-                    }// end if (potentialSpaces == 2)
-                }// end if (gridPotential[m][n] == true)
-            }
+    return 0;
+}// end int runConvertMode(bool pack, const string &inName,
+//                         const string &outName)
 
-            potentialSpaces = 0;
-        }
 
-    }// end else if (potentialSpaces == 2)
 
+/******************************************************************************/
+/**
 
+ Answers puzzles as a daemon (server.h) until it is stopped: on a Unix
+ domain socket at path, or on standard input and output if path is "-".
+ threads is the number of solving threads, 0 for one per core, and
+ cacheSize above 0 caches that many solutions (cache.h). counterName "json"
+ or "prometheus" counts what each stage of solving does, for the STATS
+ command (counters.h). Every puzzle is held to limits (budget.h).
 
-    potentialSpaces = 0;
+**/
+/******************************************************************************/
 
 
 
-    /// Middle right 3x3 grid
-    for (int m = 3; m < 6; m++)
-        for (int n = 6; n < 9; n++)
-            if (gridPotential[m][n] == true)
-            {
-                potentialSpaces++;
-            }
+int runServerMode(const string &path, const string &engineName, int threads,
+                  long cacheSize, const string &counterName,
+                  const Budget &limits)
+{
+    Server server;
+    Engine engine;
+    CounterFormat counters = COUNTERS_OFF;
+    bool served;
 
-    if (potentialSpaces == 1)
+    if (!parseEngine(engineName, engine) || engine == LOCKSTEP)
     {
-        for (int m = 3; m < 6; m++)
-            for (int n = 6; n < 9; n++)
-                if (gridPotential[m][n] == true)
-                {
-                    arr[m][n] = i;
-
-                    change = true;
-
-                    leftToSolve--;
-
-                    squareEliminator(gridPotential, m, n);
+        cerr << "unknown daemon engine: " << engineName << endl;
+        return 1;
+    }
 
-                    elimination = true;
+    if (!counterName.empty() && !parseCounterFormat(counterName, counters))
+    {
+        cerr << "unknown counter format: " << counterName << endl;
+        return 1;
+    }
 
-                    display(arr);
+    startServer(server, engine, threads, size_t(cacheSize), counters,
+                limits);
 
-                    cout << leftToSolve << endl;
+    if (path == "-")
+        served = serveStream(server, 0, 1);
+    else
+        served = serveSocket(server, path.c_str());
 
-                }
+    stopServer(server);
 
-    }// end if (potentialSpaces == 1)
-    else if (potentialSpaces == 2)
-    {
-        potentialSpaces = 0;
+    return served ? 0 : 1;
+}// end int runServerMode(const string &path, const string &engineName,
+//                        int threads, long cacheSize,
+//                        const string &counterName, const Budget &limits)
 
-        /// If the 2 potential spaces line up in a row within a
-        /// 3x3 grid, that row is eliminated because it is already
-        /// taken by the number, i, in that 3x3 grid
-        for (int m = 3; m < 6; m++)
-        {
-            for (int n = 6; n < 9; n++)
-            {
-                if (gridPotential[m][n] == true)
-                {
-                    potentialSpaces++;
-
-                    if (potentialSpaces == 2)
-                    {
-                        for (int j = 0; j < 9; j++)
-                        {
-                            gridPotential[m][j] = false;
-
-                            elimination = true;
-                        }// end for (int j = 0; j < 9; j++)
-                    }// end if (potentialSpaces == 2)
-                }// end if (gridPotential[m][n] == true)
-            }
 
-            potentialSpaces = 0;
-        }
 
+/******************************************************************************/
 
+int main(int argc, char *argv[])
+{
+    int board[9][9], numToSolve = 0, startingFilled;
+    string engine, batchFile, traceKind, traceFile, symmetry = "none";
+    string convertIn, convertOut, daemon, counterName;
+    bool batch = false, ordered = true, grade = false, pack = false;
+    bool seeded = false;
+    int threads = 0, countLimit = 0, clues = 0;
+    long generate = 0, cacheSize = 0, nodeLimit = 0, restartLimit = 0;
+    long timeLimit = 0;
+    unsigned long long seed = 1;
+    ofstream traceLog;
+    ostream *traceOut = &cout;
+    Budget limits;
 
-        /// If the 2 potential spaces line up in a column within a
-        /// 3x3 grid, that column is eliminated because it is
-        /// already taken by the number, i, in that 3x3 grid
-        for (int n = 6; n < 9; n++)
+    bool fillBoard(int [][9], int &);
+    int runBatchMode(const string &, const string &, int, bool, int, bool,
+                     long, const string &, const Budget &);
+    int runGenerateMode(long, unsigned long long, int, const string &, int);
+    int runConvertMode(bool, const string &, const string &);
+    int runServerMode(const string &, const string &, int, long,
+                      const string &, const Budget &);
+
+
+    /// -e picks what to do when logic alone is not enough, -b solves every
+    /// puzzle in a file, or standard input for "-", one per line, on -t
+    /// threads. -u writes batch solutions as they are found, numbered. -c
+    /// counts the solutions of each puzzle instead, up to 2 or the limit
+    /// given, and -r grades them. -m caches solutions and -P counts what
+    /// each stage of solving does. -v traces every step of a single puzzle
+    /// as a board, text or binary, to standard output or the file given
+    /// with -l. -g makes new puzzles instead, from seed -s, down to -k clues
+    /// with symmetry -y. -p packs a text file into a binary one, -x unpacks
+    /// one. -d answers puzzles as a daemon. -n, -R and -w give up on a
+    /// puzzle after that many guesses, restarts or milliseconds. -s seeds
+    /// brute force too.
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+
+        if (arg == "-e" && i + 1 < argc)
+            engine = argv[++i];
+        else if (arg == "-b" && i + 1 < argc)
         {
-            for (int m = 3; m < 6; m++)
-            {
-                if (gridPotential[m][n] == true)
-                {
-                    potentialSpaces++;
-
-                    if (potentialSpaces == 2)
-                    {
-                        for (int j = 0; j < 9; j++)
-                        {
-                            gridPotential[j][n] = false;
-
-                            elimination = true;
-                        }// end for (int j = 0; j < 9; j++)
-                    }// end if (potentialSpaces == 2)
-                }// end if (gridPotential[m][n] == true)
-            }
-
-            potentialSpaces = 0;
+            batch = true;
+            batchFile = argv[++i];
         }
-
-    }// end else if (potentialSpaces == 2)
-
-
-
-    potentialSpaces = 0;
-
-
-
-    /// Bottom left 3x3 grid
-    for (int m = 6; m < 9; m++)
-        for (int n = 0; n < 3; n++)
-            if (gridPotential[m][n] == true)
-            {
-                potentialSpaces++;
-            }
-
-    if (potentialSpaces == 1)
-    {
-        for (int m = 6; m < 9; m++)
-            for (int n = 0; n < 3; n++)
-                if (gridPotential[m][n] == true)
-                {
-                    arr[m][n] = i;
-
-                    change = true;
-
-                    leftToSolve--;
-
-                    squareEliminator(gridPotential, m, n);
-
-                    elimination = true;
-
-                    display(arr);
-
-                    cout << leftToSolve << endl;
-
-                }
-
-    }// end if (potentialSpaces == 1)
-    else if (potentialSpaces == 2)
-    {
-        potentialSpaces = 0;
-
-        /// If the 2 potential spaces line up in a row within a
-        /// 3x3 grid, that row is eliminated because it is already
-        /// taken by the number, i, in that 3x3 grid
-        for (int m = 6; m < 9; m++)
+        else if (arg == "-t" && i + 1 < argc)
+            threads = atoi(argv[++i]);
+        else if (arg == "-u")
+            ordered = false;
+        else if (arg == "-v" && i + 1 < argc)
+            traceKind = argv[++i];
+        else if (arg == "-l" && i + 1 < argc)
+            traceFile = argv[++i];
+        else if (arg == "-g" && i + 1 < argc)
+            generate = atol(argv[++i]);
+        else if (arg == "-s" && i + 1 < argc)
         {
-            for (int n = 0; n < 3; n++)
-            {
-                if (gridPotential[m][n] == true)
-                {
-                    potentialSpaces++;
-
-                    if (potentialSpaces == 2)
-                    {
-                        for (int j = 0; j < 9; j++)
-                        {
-                            gridPotential[m][j] = false;
-
-                            elimination = true;
-                        }// end for (int j = 0; j < 9; j++)
-                    }// end if (potentialSpaces == 2)
-                }// end if (gridPotential[m][n] == true)
-            }
-
-            potentialSpaces = 0;
+            seeded = true;
+            seed = strtoull(argv[++i], NULL, 10);
         }
-
-
-
-        /// If the 2 potential spaces line up in a column within a
-        /// 3x3 grid, that column is eliminated because it is
-        /// already taken by the number, i, in that 3x3 grid
-        for (int n = 0; n < 3; n++)
+        else if (arg == "-k" && i + 1 < argc)
+            clues = atoi(argv[++i]);
+        else if (arg == "-y" && i + 1 < argc)
+            symmetry = argv[++i];
+        else if (arg == "-r")
+            grade = true;
+        else if (arg == "-m" && i + 1 < argc)
+            cacheSize = atol(argv[++i]);
+        else if (arg == "-d" && i + 1 < argc)
+            daemon = argv[++i];
+        else if (arg == "-P" && i + 1 < argc)
+            counterName = argv[++i];
+        else if (arg == "-n" && i + 1 < argc)
+            nodeLimit = atol(argv[++i]);
+        else if (arg == "-R" && i + 1 < argc)
+            restartLimit = atol(argv[++i]);
+        else if (arg == "-w" && i + 1 < argc)
+            timeLimit = atol(argv[++i]);
+        else if ((arg == "-p" || arg == "-x") && i + 2 < argc)
         {
-            for (int m = 6; m < 9; m++)
-            {
-                if (gridPotential[m][n] == true)
-                {
-                    potentialSpaces++;
-
-                    if (potentialSpaces == 2)
-                    {
-                        for (int j = 0; j < 9; j++)
-                        {
-                            gridPotential[j][n] = false;
-
-                            elimination = true;
-                        }// end for (int j = 0; j < 9; j++)
-                    }// end if (potentialSpaces == 2)
-                }// end if (gridPotential[m][n] == true)
-            }
-
-            potentialSpaces = 0;
+            pack = arg == "-p";
+            convertIn = argv[++i];
+            convertOut = argv[++i];
         }
-
-    }// end else if (potentialSpaces == 2)
-
-
-
-    potentialSpaces = 0;
-
-
-
-    /// Bottom center 3x3 grid
-    for (int m = 6; m < 9; m++)
-        for (int n = 3; n < 6; n++)
-            if (gridPotential[m][n] == true)
-            {
-                potentialSpaces++;
-            }
-
-    if (potentialSpaces == 1)
-    {
-        for (int m = 6; m < 9; m++)
-            for (int n = 3; n < 6; n++)
-                if (gridPotential[m][n] == true)
-                {
-                    arr[m][n] = i;
-
-                    change = true;
-
-                    leftToSolve--;
-
-                    squareEliminator(gridPotential, m, n);
-
-                    elimination = true;
-
-                    display(arr);
-
-                    cout << leftToSolve << endl;
-
-                }
-
-    }// end if (potentialSpaces == 1)
-    else if (potentialSpaces == 2)
-    {
-        potentialSpaces = 0;
-
-        /// If the 2 potential spaces line up in a row within a
-        /// 3x3 grid, that row is eliminated because it is already
-        /// taken by the number, i, in that 3x3 grid
-        for (int m = 6; m < 9; m++)
+        else if (arg == "-c")
         {
-            for (int n = 3; n < 6; n++)
-            {
-                if (gridPotential[m][n] == true)
-                {
-                    potentialSpaces++;
-
-                    if (potentialSpaces == 2)
-                    {
-                        for (int j = 0; j < 9; j++)
-                        {
-                            gridPotential[m][j] = false;
-
-                            elimination = true;
-                        }// end for (int j = 0; j < 9; j++)
-                    }// end if (potentialSpaces == 2)
-                }// end if (gridPotential[m][n] == true)
-            }
+            countLimit = 2;
 
-            potentialSpaces = 0;
+            if (i + 1 < argc && isdigit(argv[i + 1][0]))
+                countLimit = atoi(argv[++i]);
         }
-
-
-
-        /// If the 2 potential spaces line up in a column within a
-        /// 3x3 grid, that column is eliminated because it is
-        /// already taken by the number, i, in that 3x3 grid
-        for (int n = 3; n < 6; n++)
+        else
         {
-            for (int m = 6; m < 9; m++)
-            {
-                if (gridPotential[m][n] == true)
-                {
-                    potentialSpaces++;
-
-                    if (potentialSpaces == 2)
-                    {
-                        for (int j = 0; j < 9; j++)
-                        {
-                            gridPotential[j][n] = false;
-
-                            elimination = true;
-                        }// end for (int j = 0; j < 9; j++)
-                    }// end if (potentialSpaces == 2)
-                }// end if (gridPotential[m][n] == true)
-            }
-
-            potentialSpaces = 0;
+            cout << "usage: " << argv[0] << " [-e brute|dfs|dlx]"
+                 << " [-v board|text|binary] [-l file] [-n nodes]"
+                 << " [-R restarts] [-w ms] [-s seed]" << endl
+                 << "       " << argv[0]
+                 << " -b file|- [-e dfs|dlx|simd] [-t threads] [-u]"
+                 << " [-c [limit] | -r] [-m cache] [-P json|prometheus]"
+                 << " [-n nodes] [-R restarts] [-w ms]" << endl
+                 << "       " << argv[0] << " -g count [-s seed] [-k clues]"
+                 << " [-y none|rotational|mirror] [-t threads]" << endl
+                 << "       " << argv[0] << " -p text|- packed" << endl
+                 << "       " << argv[0] << " -x packed text|-" << endl
+                 << "       " << argv[0] << " -d socket|- [-e dfs|dlx]"
+                 << " [-t threads] [-m cache] [-P json|prometheus]"
+                 << " [-n nodes] [-R restarts] [-w ms]" << endl;
+            return 1;
         }
+    }
 
-    }// end else if (potentialSpaces == 2)
+    initBudget(limits);
+    limits.maxNodes = nodeLimit;
+    limits.maxRestarts = restartLimit;
+    limits.timeLimit = timeLimit * 1000;
 
+    if (!convertIn.empty())
+        return runConvertMode(pack, convertIn, convertOut);
 
+    if (!daemon.empty())
+        return runServerMode(daemon, engine.empty() ? "dfs" : engine,
+                             threads, cacheSize, counterName, limits);
 
-    potentialSpaces = 0;
+    if (generate > 0)
+        return runGenerateMode(generate, seed, clues, symmetry, threads);
 
+    if (batch)
+        return runBatchMode(batchFile, engine.empty() ? "dfs" : engine,
+                            threads, ordered, countLimit, grade, cacheSize,
+                            counterName, limits);
 
+    if (engine.empty())
+        engine = "brute";
 
-    /// Bottom right 3x3 grid
-    for (int m = 6; m < 9; m++)
-        for (int n = 6; n < 9; n++)
-            if (gridPotential[m][n] == true)
-            {
-                potentialSpaces++;
-            }
-
-    if (potentialSpaces == 1)
+    if (engine != "brute" && engine != "dfs" && engine != "dlx")
     {
-        for (int m = 6; m < 9; m++)
-            for (int n = 6; n < 9; n++)
-                if (gridPotential[m][n] == true)
-                {
-                    arr[m][n] = i;
-
-                    change = true;
-
-                    leftToSolve--;
-
-                    squareEliminator(gridPotential, m, n);
-
-                    elimination = true;
-
-                    display(arr);
-
-                    cout << leftToSolve << endl;
+        cout << "unknown engine: " << engine << endl;
+        return 1;
+    }
 
-                }
+    if (!seeded)
+        seed = (unsigned long long)time(0);
 
-    }// end if (potentialSpaces == 1)
-    else if (potentialSpaces == 2)
+    if (!traceKind.empty() && traceKind != "board" && traceKind != "text" &&
+        traceKind != "binary")
     {
-        potentialSpaces = 0;
-
-        /// If the 2 potential spaces line up in a row within a
-        /// 3x3 grid, that row is eliminated because it is already
-        /// taken by the number, i, in that 3x3 grid
-        for (int m = 6; m < 9; m++)
-        {
-            for (int n = 6; n < 9; n++)
-            {
-                if (gridPotential[m][n] == true)
-                {
-                    potentialSpaces++;
-
-                    if (potentialSpaces == 2)
-                    {
-                        for (int j = 0; j < 9; j++)
-                        {
-                            gridPotential[m][j] = false;
-
-                            elimination = true;
-                        }// end for (int j = 0; j < 9; j++)
-                    }// end if (potentialSpaces == 2)
-                }// end if (gridPotential[m][n] == true)
-            }
-
-            potentialSpaces = 0;
-        }
-
-
-
-        /// If the 2 potential spaces line up in a column within a
-        /// 3x3 grid, that column is eliminated because it is
-        /// already taken by the number, i, in that 3x3 grid
-        for (int n = 6; n < 9; n++)
-        {
-            for (int m = 6; m < 9; m++)
-            {
-                if (gridPotential[m][n] == true)
-                {
-                    potentialSpaces++;
-
-                    if (potentialSpaces == 2)
-                    {
-                        for (int j = 0; j < 9; j++)
-                        {
-                            gridPotential[j][n] = false;
-
-                            elimination = true;
-                        }// end for (int j = 0; j < 9; j++)
-                    }// end if (potentialSpaces == 2)
-                }// end if (gridPotential[m][n] == true)
-            }
-
-            potentialSpaces = 0;
-        }
-
-    }// end else if (potentialSpaces == 2)
-
-
-
-}// end void actualAddAndElimPotentialElim(int arr[][9],
-//                                        bool gridPotential[][9],
-//                                        bool &elimination, bool &change,
-//                                        int &leftToSolve)
-
-
-
-/******************************************************************************/
-/**
-
- Applies brute force to the array to solve it. Will solve any puzzle.
-
- At each empty square, takes a randomly selected potential number of
- that square and tests to see if it was already used in the row,
- column or 3x3 grid. If it was not used, adds it to the square and goes
- to the next empty square. If it was used, picks another randomly
- selected potential number of that square and tests it. If all the
- potential numbers of an empty square are already taken, a new brute
- force attempt is started. Brute force is applied until the puzzle
- is solved.
-
-**/
-/******************************************************************************/
-
-
-
-bool bruteForce(int arr[][9])
-{
-    int numberOfPotentials[9][9], potentialNumbers[9][9][9], randomPotential,
-        arrCopy[9][9], numbersTriedCount;
-    bool gridPotential[9][9], repeat, usedNumbers[9], taken, run;
-
-    void squareEliminator(bool [][9], int, int);
-    void display(int [][9]);
-
-
-    for (int m = 0; m < 9; m++)
-        for (int n = 0; n < 9; n++)
-        {
-            numberOfPotentials[m][n] = 0;
-        }
-
-
-
+        cout << "unknown trace: " << traceKind << endl;
+        return 1;
+    }
 
-    /// Takes each number and checks for all the rows, columns and 3x3 grids
-    /// that are already occupied by it on the board. It then adds that
-    /// number to the next available slot of all other squares in a 3
-    /// dimensional array and keeps track of how many potential numbers are on
-    /// each square.
-    for (int i = 1; i <= 9; i++)
+    if (!traceFile.empty())
     {
+        traceLog.open(traceFile.c_str(), ios::binary);
 
-        /// Initialize all the squares to false if they are occupied
-        /// and true if they are empty
-        for (int m = 0; m < 9; m++)
-            for (int n = 0; n < 9; n++)
-                if (arr[m][n] > 0)
-                {
-                    gridPotential[m][n] = false;
-                }
-                else
-                {
-                    gridPotential[m][n] = true;
-                }
-
-
-
-
-        for (int j = 0; j < 9; j++)
-            for (int k = 0; k < 9; k++)
-            {
-
-                if (arr[j][k] == i)
-                {
-                    /// Eliminates the column, row and 3x3 grid the
-                    /// number occupies
-                    squareEliminator(gridPotential, j, k);
-
-
-
-                    /// This row has already been eliminated, start at the
-                    /// beginning of the next row. k is negative one
-                    /// because it will be incremented to 0 at the start of
-                    /// it's for loop. If j equals 8, incrementing j would
-                    /// cause the next set of test parameters to be
-                    /// 9 and 0 which is outside the range of the array
-                    if (j != 8)
-                    {
-                        k = -1;
-                        j++;
-                    }
-                }// end if (arr[j][k] == i)
-            }
-
-
-
-
-        /// Adds the number to the next available slot on each square that was
-        /// not part of a row, column or 3x3 grid that was already occupied
-        /// by the number and increments the count for each square the number
-        /// is added to
-        for (int j = 0; j < 9; j++)
-            for (int k = 0; k < 9; k++)
-                if (gridPotential[j][k] == true)
-                {
-                    potentialNumbers[j][k][numberOfPotentials[j][k]] = i;
-
-                    numberOfPotentials[j][k]++;
-                }
-
-
-
-    }// end for (int i = 1; i <= 9; i++)
-
-    cout << endl;
-    cout << "Brute force being applied, please wait..." << endl << endl;
-
-
-
-    /// Seed random number generator with current time
-    srand(time(0));
-
-
-
-    /// At each empty square, takes a randomly selected potential number of
-    /// that square and tests to see if it was already used in the row,
-    /// column or 3x3 grid. If it was not used, adds it to the square and goes
-    /// to the next empty square. If it was used, picks another randomly
-    /// selected potential number of that square and tests it. If all the
-    /// potential numbers of an empty square are already taken, a new brute
-    /// force attempt is started. Brute force is applied until the puzzle
-    /// is solved.
-    for (int j = 0; j < 9; j++)
-    {
-        for (int k = 0; k < 9; k++)
+        if (!traceLog.is_open())
         {
+            cout << "ERROR: unable to open " << traceFile << endl;
+            return 1;
+        }
 
-            /// Initializes arrCopy to arr's state at the start of each brute
-            /// force attempt
-            if (j == 0 && k == 0)
-            {
-                for (int m = 0; m < 9; m++)
-                    for (int n = 0; n < 9; n++)
-                    {
-                        arrCopy[m][n] = arr[m][n];
-                    }
-
-            }// end if (j == 0 && k == 0)
-
-
-
-            if (arrCopy[j][k] == 0)
-            {
-                for (int m = 0; m < 9; m++)
-                {
-                    usedNumbers[m] = false;
-                }
-
-                repeat = false;
-
-                numbersTriedCount = 0;
-
-                do
-                {
-
-                    do
-                    {
-                        randomPotential =
-                            potentialNumbers
-                            [j][k][rand() % numberOfPotentials[j][k]];
-
-                        if (usedNumbers[randomPotential - 1] == false)
-                        {
-                            repeat = false;
-
-                            run = true;
-
-                            usedNumbers[randomPotential - 1] = true;
-
-                            numbersTriedCount++;
-
-
-                        }// end if (usedNumbers[randomPotential - 1] == false)
-                        else
-                        {
-                            repeat = true;
-
-                            /// Ends this brute force attempt
-                            if (numbersTriedCount == numberOfPotentials[j][k])
-                            {
-                                j = 0;
-
-                                k = -1;
-
-                                /// Breaks out of the do while loops
-
-                                repeat = false;
-
-                                run = false;
-
-                                taken = false;
-                            }
-                        }
-
-                    }
-                    while(repeat);
-
-
-                    if (run)
-                    {
-
-
-                        taken = false;
-
-                        /// Checks the row of the square to see if the number
-                        /// was already used
-                        for (int i = 0; i < 9; i++)
-                        {
-                            if (arrCopy[j][i] == randomPotential)
-                            {
-                                taken = true;
-                            }// end if (arrCopy[j][i] == randomPotential)
-
-                        }// end for (int i = 0; i < 9; i++)
-
-
-                        if (!taken)
-                        {
-
-                            /// Checks the column of the square to see if the
-                            /// number was already used
-                            for (int i = 0; i < 9; i++)
-                            {
-                                if (arrCopy[i][k] == randomPotential)
-                                {
-                                    taken = true;
-
-                                }// end if (arrCopy[i][k] == randomPotential)
-
-                            }// end for (int i = 0; i < 9; i++)
-
-
-
-                            if (!taken)
-                            {
-
-                                /// This section checks within the 3 x 3 grid
-                                /// of the square being tested to see if the
-                                /// number was already used
-
-                                /// Top left 3x3 grid
-                                if (j <= 2 && k <=2)
-                                {
-                                    for (int m = 0; m < 3; m++)
-                                        for (int n = 0; n < 3; n++)
-                                            if
-                                            (arrCopy[m][n] == randomPotential)
-                                            {
-                                                taken = true;
-
-                                            }
-                                }
-                                /// Top center 3x3 grid
-                                else if (j <= 2 && (k >= 3 && k <= 5))
-                                {
-                                    for (int m = 0; m < 3; m++)
-                                        for (int n = 3; n < 6; n++)
-                                            if
-                                            (arrCopy[m][n] == randomPotential)
-                                            {
-                                                taken = true;
-
-                                            }
-                                }
-                                /// Top right 3x3 grid
-                                else if (j <= 2 && (k >= 6 && k <= 8))
-                                {
-                                    for (int m = 0; m < 3; m++)
-                                        for (int n = 6; n < 9; n++)
-                                            if
-                                            (arrCopy[m][n] == randomPotential)
-                                            {
-                                                taken = true;
-
-                                            }
-                                }
-                                /// Middle left 3x3 grid
-                                else if ((j >= 3 && j <= 5) && k <=2)
-                                {
-                                    for (int m = 3; m < 6; m++)
-                                        for (int n = 0; n < 3; n++)
-                                            if
-                                            (arrCopy[m][n] == randomPotential)
-                                            {
-                                                taken = true;
-
-                                            }
-                                }
-                                /// Middle center 3x3 grid
-                                else if ((j >= 3 && j <= 5) &&
-                                         (k >= 3 && k <= 5))
-                                {
-                                    for (int m = 3; m < 6; m++)
-                                        for (int n = 3; n < 6; n++)
-                                            if
-                                            (arrCopy[m][n] == randomPotential)
-                                            {
-                                                taken = true;
-
-                                            }
-                                }
-                                /// Middle right 3x3 grid
-                                else if ((j >= 3 && j <= 5) &&
-                                         (k >= 6 && k <= 8))
-                                {
-                                    for (int m = 3; m < 6; m++)
-                                        for (int n = 6; n < 9; n++)
-                                            if
-                                            (arrCopy[m][n] == randomPotential)
-                                            {
-                                                taken = true;
-
-                                            }
-                                }
-                                /// Bottom left 3x3 grid
-                                else if ((j >= 6 && j <= 8) && k <=2)
-                                {
-                                    for (int m = 6; m < 9; m++)
-                                        for (int n = 0; n < 3; n++)
-                                            if
-                                            (arrCopy[m][n] == randomPotential)
-                                            {
-                                                taken = true;
-
-                                            }
-                                }
-                                /// Bottom center 3x3 grid
-                                else if ((j >= 6 && j <= 8) &&
-                                         (k >= 3 && k <= 5))
-                                {
-                                    for (int m = 6; m < 9; m++)
-                                        for (int n = 3; n < 6; n++)
-                                            if
-                                            (arrCopy[m][n] == randomPotential)
-                                            {
-                                                taken = true;
-
-                                            }
-                                }
-                                /// Bottom right 3x3 grid
-                                else
-                                {
-                                    for (int m = 6; m < 9; m++)
-                                        for (int n = 6; n < 9; n++)
-                                            if
-                                            (arrCopy[m][n] == randomPotential)
-                                            {
-                                                taken = true;
-
-                                            }
-                                }
-
-
-
-                                /// If the number is not taken in the row,
-                                /// column, or 3x3 grid, it is placed on
-                                /// the square
-                                if (!taken)
-                                {
-                                    arrCopy[j][k] = randomPotential;
-                                }
-
-
-                            }// end if (!taken)
-
-                        }// end if (!taken)
-
-                    }// end if (run)
-
-                }
-                while (taken);
-
-            }// end if (arrCopy[j][k] == 0)
-
-        }// end for (int k = 0; k < 9; k++)
-    }// end for (int j = 0; j < 9; j++)
-
-    display(arrCopy);
-
-    return true;
-
-}// end bool bruteForce(int arr[][9])
-
-/******************************************************************************/
-
-int main()
-{
-    int board[9][9], numToSolve = 0, startingFilled;
-
-    bool fillBoard(int [][9], int &);
-    bool solve(int [][9], int &);
-    bool bruteForce(int [][9]);
+        traceOut = &traceLog;
+    }
 
 
     if(!fillBoard(board, numToSolve))
@@ -1869,13 +762,28 @@ int main()
     {
         startingFilled = 81 - numToSolve;
 
-        if(!solve(board, numToSolve))
+        if (traceKind.empty())
         {
-            cout << "Oh, no!" << endl;
-
-            if (bruteForce(board))
-                cout << "Brute force for the win!" << endl << endl;
+            NullTrace trace;
+            solvePuzzle(board, numToSolve, engine, trace, limits, seed);
+        }
+        else if (traceKind == "board")
+        {
+            BoardTrace trace(*traceOut);
+            solvePuzzle(board, numToSolve, engine, trace, limits, seed);
+        }
+        else if (traceKind == "text")
+        {
+            TextTrace trace(*traceOut);
+            solvePuzzle(board, numToSolve, engine, trace, limits, seed);
         }
+        else
+        {
+            BinaryTrace trace(*traceOut);
+            solvePuzzle(board, numToSolve, engine, trace, limits, seed);
+        }
+
+        traceOut->flush();
 
         cout << "Number filled at start: " << startingFilled << endl;
     }
@@ -0,0 +1,310 @@
+/**
+  Name: packed.cpp
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Packed binary puzzle files. See packed.h.
+*/
+
+#include <cstring>
+
+#include "corpus.h"
+#include "packed.h"
+
+using namespace std;
+
+static const char PACKED_MAGIC[4] = { 'S', 'D', 'K', 'P' };
+
+
+
+/******************************************************************************/
+/**
+
+ Whether data starts like a packed file, so a reader can tell it from text.
+
+**/
+/******************************************************************************/
+
+
+
+bool isPacked(const char *data, size_t size)
+{
+    return size >= sizeof PACKED_MAGIC &&
+           memcmp(data, PACKED_MAGIC, sizeof PACKED_MAGIC) == 0;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Reads the header at the start of data, size bytes long. Returns false with
+ the reason in error if it is not a packed file, is of a version or board
+ size this program cannot read, or is not exactly as long as its header
+ says: cut short, or with bytes after the last record.
+
+**/
+/******************************************************************************/
+
+
+
+bool readPackedHeader(const char *data, size_t size, PackedHeader &header,
+                      string &error)
+{
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data);
+    unsigned long long count = 0;
+
+    if (size < PACKED_HEADER || !isPacked(data, size))
+    {
+        error = "not a packed puzzle file";
+        return false;
+    }
+
+    header.version = bytes[4];
+    header.side = bytes[5];
+    header.count = 0;
+
+    for (int i = 7; i >= 0; i--)
+        count = (count << 8) | bytes[8 + i];
+
+    if (header.version != PACKED_VERSION)
+    {
+        error = "packed file version " + to_string(header.version) +
+                ", expected " + to_string(PACKED_VERSION);
+        return false;
+    }
+
+    if (header.side != SIDE)
+    {
+        error = "packed file of " + to_string(header.side) + "x" +
+                to_string(header.side) + " puzzles, only 9x9 can be read";
+        return false;
+    }
+
+    /// Checked before it is made signed, so no count in a file can overflow
+    if (count > (size - PACKED_HEADER) / PACKED_RECORD)
+    {
+        error = "packed file cut short: " + to_string(count) +
+                " records in the header, room for " +
+                to_string((size - PACKED_HEADER) / PACKED_RECORD);
+        return false;
+    }
+
+    if (size - PACKED_HEADER != count * PACKED_RECORD)
+    {
+        error = "packed file has " +
+                to_string(size - PACKED_HEADER - count * PACKED_RECORD) +
+                " bytes after its " + to_string(count) + " records";
+        return false;
+    }
+
+    header.count = (long long)count;
+
+    return true;
+}// end bool readPackedHeader(const char *data, size_t size,
+//                           PackedHeader &header, string &error)
+
+
+
+/******************************************************************************/
+/**
+
+ Writes the header for a file of count records to out, PACKED_HEADER bytes.
+
+**/
+/******************************************************************************/
+
+
+
+void writePackedHeader(char *out, long long count)
+{
+    memcpy(out, PACKED_MAGIC, sizeof PACKED_MAGIC);
+
+    out[4] = char(PACKED_VERSION);
+    out[5] = char(SIDE);
+    out[6] = 0;
+    out[7] = 0;
+
+    for (int i = 0; i < 8; i++)
+        out[8 + i] = char((unsigned long long)count >> (8 * i));
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Packs the array into PACKED_RECORD bytes at out, square 2i in the low half
+ of byte i and square 2i + 1 in the high half.
+
+**/
+/******************************************************************************/
+
+
+
+void packRecord(const int arr[][SIDE], unsigned char *out)
+{
+    memset(out, 0, PACKED_RECORD);
+
+    for (int cell = 0; cell < CELLS; cell++)
+        out[cell / 2] |= (unsigned char)(arr[rowOf(cell)][colOf(cell)] <<
+                                         (4 * (cell & 1)));
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Fills the array from a record packed by packRecord(). Returns false if a
+ square holds more than 9, which only a damaged file can.
+
+**/
+/******************************************************************************/
+
+
+
+bool unpackRecord(const unsigned char *in, int arr[][SIDE])
+{
+    bool valid = true;
+
+    for (int cell = 0; cell < CELLS; cell++)
+    {
+        int value = (in[cell / 2] >> (4 * (cell & 1))) & 15;
+
+        if (value > SIDE)
+            valid = false;
+
+        arr[rowOf(cell)][colOf(cell)] = value;
+    }
+
+    return valid;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Record number index, from 0, of the packed file in data. The header must
+ have been checked with readPackedHeader().
+
+**/
+/******************************************************************************/
+
+
+
+const unsigned char *packedRecord(const char *data, long long index)
+{
+    return reinterpret_cast<const unsigned char *>(data) + PACKED_HEADER +
+           size_t(index) * PACKED_RECORD;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Packs every puzzle line of in, in the text format of corpus.h, into out.
+ Empty lines are skipped quietly, and a line that is not a puzzle is
+ reported on standard error with its line number and counted in skipped.
+ Returns the number of records written.
+
+ The count in the header is only known at the end, so out has to be a file
+ it can seek back to the start of.
+
+**/
+/******************************************************************************/
+
+
+
+long long packText(istream &in, ostream &out, long &skipped)
+{
+    char header[PACKED_HEADER];
+    unsigned char record[PACKED_RECORD];
+    int arr[SIDE][SIDE];
+    long long count = 0;
+    long lineNumber = 0;
+    string line, error;
+
+    skipped = 0;
+
+    writePackedHeader(header, 0);
+    out.write(header, PACKED_HEADER);
+
+    while (getline(in, line))
+    {
+        lineNumber++;
+
+        if (line.find_first_not_of(" \t\r") == string::npos)
+            continue;
+
+        if (!parsePuzzle(line.data(), line.size(), arr, error))
+        {
+            cerr << "line " << lineNumber << ": " << error << endl;
+            skipped++;
+            continue;
+        }
+
+        packRecord(arr, record);
+        out.write(reinterpret_cast<const char *>(record), PACKED_RECORD);
+
+        count++;
+    }
+
+    writePackedHeader(header, count);
+    out.seekp(0);
+    out.write(header, PACKED_HEADER);
+
+    return count;
+}// end long long packText(istream &in, ostream &out, long &skipped)
+
+
+
+/******************************************************************************/
+/**
+
+ Writes every record of the packed file in data, size bytes long, to out as
+ a line of text in the format of corpus.h. Returns the number of records
+ written, which is the count in the header, or -1 with the reason in error
+ if data is not a packed file this program can read, or has a damaged
+ record.
+
+**/
+/******************************************************************************/
+
+
+
+long long unpackText(const char *data, size_t size, ostream &out,
+                     string &error)
+{
+    PackedHeader header;
+    int arr[SIDE][SIDE];
+    char line[CELLS + 1];
+
+    if (!readPackedHeader(data, size, header, error))
+        return -1;
+
+    line[CELLS] = '\n';
+
+    for (long long i = 0; i < header.count; i++)
+    {
+        if (!unpackRecord(packedRecord(data, i), arr))
+        {
+            error = "record " + to_string(i + 1) + " is damaged";
+            return -1;
+        }
+
+        for (int cell = 0; cell < CELLS; cell++)
+        {
+            int value = arr[rowOf(cell)][colOf(cell)];
+
+            line[cell] = value ? char('0' + value) : '.';
+        }
+
+        out.write(line, CELLS + 1);
+    }
+
+    return header.count;
+}// end long long unpackText(const char *data, size_t size, ostream &out,
+//                          string &error)
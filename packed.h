@@ -0,0 +1,60 @@
+/**
+  Name: packed.h
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Packed binary puzzle files. Every puzzle or solution takes 41
+  bytes, half a byte per square (0 for empty, the low half first), against
+  82 for a line of text, and needs no parsing to read.
+
+  The file starts with a 16 byte header:
+
+    bytes 0 - 3    "SDKP"
+    byte  4        version, PACKED_VERSION
+    byte  5        side of the board, 9
+    bytes 6 - 7    0
+    bytes 8 - 15   number of records, least significant byte first
+
+  followed by the records one after another. Every record is the same size,
+  so record i can be read straight out of a mapped file (corpus.h) without
+  reading the ones before it.
+
+  packText() and unpackText() convert to and from the one puzzle per line
+  text format (corpus.h). Batch mode reads packed files as they are
+  (batch.h).
+*/
+
+#ifndef PACKED_H
+#define PACKED_H
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+#include "board.h"
+
+const int PACKED_VERSION = 1;
+const size_t PACKED_HEADER = 16;                    // bytes before the records
+const size_t PACKED_RECORD = (CELLS + 1) / 2;       // bytes per record
+
+struct PackedHeader
+{
+    int version;
+    int side;
+    long long count;                // records in the file
+};
+
+bool isPacked(const char *data, size_t size);
+bool readPackedHeader(const char *data, size_t size, PackedHeader &header,
+                      std::string &error);
+void writePackedHeader(char *out, long long count);
+
+void packRecord(const int arr[][SIDE], unsigned char *out);
+bool unpackRecord(const unsigned char *in, int arr[][SIDE]);
+const unsigned char *packedRecord(const char *data, long long index);
+
+long long packText(std::istream &in, std::ostream &out, long &skipped);
+long long unpackText(const char *data, size_t size, std::ostream &out,
+                     std::string &error);
+
+#endif // PACKED_H
@@ -0,0 +1,197 @@
+/**
+  Name: pool.cpp
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Work stealing thread pool. See pool.h.
+*/
+
+#include "pool.h"
+
+using namespace std;
+
+
+
+/******************************************************************************/
+/**
+
+ One worker per core, or one if the number of cores is unknown.
+
+**/
+/******************************************************************************/
+
+
+
+int defaultThreads()
+{
+    unsigned cores = thread::hardware_concurrency();
+
+    return cores > 0 ? int(cores) : 1;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Takes a task for worker, first from the front of its own queue, then from
+ the back of the other queues starting with its neighbour. Returns false if
+ every queue is empty.
+
+**/
+/******************************************************************************/
+
+
+
+static bool takeTask(WorkPool &pool, int worker, Task &task)
+{
+    int count = int(pool.queues.size());
+
+    for (int i = 0; i < count; i++)
+    {
+        WorkerQueue &queue = *pool.queues[(worker + i) % count];
+        lock_guard<mutex> guard(queue.lock);
+
+        if (queue.tasks.empty())
+            continue;
+
+        if (i == 0)
+        {
+            task = move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        else
+        {
+            task = move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+
+        pool.queued--;
+
+        return true;
+    }// end for (int i = 0; i < count; i++)
+
+    return false;
+}// end static bool takeTask(WorkPool &pool, int worker, Task &task)
+
+
+
+/******************************************************************************/
+/**
+
+ Runs tasks until the pool is stopped and there is nothing left to do. Sleeps
+ while every queue is empty.
+
+**/
+/******************************************************************************/
+
+
+
+static void workerLoop(WorkPool &pool, int worker)
+{
+    Task task;
+
+    for (;;)
+    {
+        if (takeTask(pool, worker, task))
+        {
+            task(worker);
+            continue;
+        }
+
+        unique_lock<mutex> guard(pool.sleepLock);
+
+        if (pool.stopping && pool.queued == 0)
+            return;
+
+        pool.wake.wait(guard, [&pool]
+        {
+            return pool.stopping || pool.queued > 0;
+        });
+    }
+}// end static void workerLoop(WorkPool &pool, int worker)
+
+
+
+/******************************************************************************/
+/**
+
+ Starts threads workers, each with an empty queue.
+
+**/
+/******************************************************************************/
+
+
+
+void startPool(WorkPool &pool, int threads)
+{
+    if (threads < 1)
+        threads = 1;
+
+    pool.queued = 0;
+    pool.stopping = false;
+    pool.next = 0;
+
+    for (int i = 0; i < threads; i++)
+        pool.queues.push_back(unique_ptr<WorkerQueue>(new WorkerQueue));
+
+    for (int i = 0; i < threads; i++)
+        pool.threads.push_back(thread(workerLoop, ref(pool), i));
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Adds a task to the back of the next worker's queue and wakes a worker up.
+ The count goes up before the sleep lock is taken, so a worker about to sleep
+ either sees the task or gets the wake up.
+
+**/
+/******************************************************************************/
+
+
+
+void submit(WorkPool &pool, const Task &task)
+{
+    WorkerQueue &queue = *pool.queues[pool.next++ % pool.queues.size()];
+
+    {
+        lock_guard<mutex> guard(queue.lock);
+        queue.tasks.push_back(task);
+    }
+
+    pool.queued++;
+
+    lock_guard<mutex> guard(pool.sleepLock);
+    pool.wake.notify_one();
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Lets the workers finish every task already submitted, then joins them.
+
+**/
+/******************************************************************************/
+
+
+
+void stopPool(WorkPool &pool)
+{
+    {
+        lock_guard<mutex> guard(pool.sleepLock);
+        pool.stopping = true;
+    }
+
+    pool.wake.notify_all();
+
+    for (size_t i = 0; i < pool.threads.size(); i++)
+        pool.threads[i].join();
+
+    pool.threads.clear();
+    pool.queues.clear();
+}
@@ -0,0 +1,53 @@
+/**
+  Name: pool.h
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Work stealing thread pool. Every worker has its own queue of
+  tasks. New tasks are handed out to the queues in turn; a worker takes tasks
+  from the front of its own queue and, once that is empty, steals from the back
+  of the other workers' queues. Puzzles can take anywhere from microseconds to
+  seconds, so a worker stuck on a hard one does not hold up the tasks queued
+  behind it for long.
+
+  Each task is told which worker is running it, so it can use state that
+  belongs to that worker without any locking.
+*/
+
+#ifndef POOL_H
+#define POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef std::function<void (int worker)> Task;
+
+struct WorkerQueue
+{
+    std::mutex lock;
+    std::deque<Task> tasks;
+};
+
+struct WorkPool
+{
+    std::vector<std::thread> threads;
+    std::vector<std::unique_ptr<WorkerQueue> > queues;
+    std::atomic<long> queued;           // tasks waiting in any queue
+    std::mutex sleepLock;               // guards stopping, used for waiting
+    std::condition_variable wake;
+    bool stopping;
+    unsigned next;                      // queue the next task goes to
+};
+
+int defaultThreads();
+void startPool(WorkPool &pool, int threads);
+void submit(WorkPool &pool, const Task &task);
+void stopPool(WorkPool &pool);
+
+#endif // POOL_H
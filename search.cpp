@@ -0,0 +1,550 @@
+/**
+  Name: search.cpp
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Logic and depth first search on the persistent board. See
+  search.h.
+*/
+
+#include "counters.h"
+#include "search.h"
+
+
+
+/******************************************************************************/
+/**
+
+ Places every number that can be found with logic alone, the same way solve()
+ does: a square with only one potential number left gets that number, and a
+ number with only one potential square left in a row, column or 3x3 grid goes
+ on that square. Repeats until nothing changes. Returns false if the board
+ runs into a contradiction, a square with no potential numbers or a number
+ with no square left in some row, column or 3x3 grid. Every number placed is
+ reported to trace, and logged on trail if there is one. Each sweep of the
+ squares and each sweep of the units is counted as a pass of its stage.
+
+**/
+/******************************************************************************/
+
+
+
+template <class Trace>
+static bool singles(Board &board, Trace &trace, Trail *trail)
+{
+    ThreadCounters *counters = stageCounters();
+    long started;
+    bool change;
+
+
+    /// Places digit, through the trail if there is one
+    auto place = [&](int cell, int digit)
+    {
+        if (trail != NULL)
+            placeDigit(board, *trail, cell, digit);
+        else
+            placeDigit(board, cell, digit);
+    };
+
+    do
+    {
+        change = false;
+
+        /// Squares with only one potential number left
+        started = startPass(counters);
+
+        for (int cell = 0; cell < CELLS; cell++)
+        {
+            if (board.value[cell] != 0)
+                continue;
+
+            if (board.cand[cell] == 0)
+            {
+                endPass(counters, STAGE_NAKED_SINGLES, started);
+                return false;
+            }
+
+            if (countDigits(board.cand[cell]) == 1)
+            {
+                int digit = firstDigit(board.cand[cell]);
+
+                place(cell, digit);
+
+                trace.place(board, cell, digit, NAKED_SINGLE);
+
+                addCount(counters, STAGE_NAKED_SINGLES, COUNT_PLACEMENTS);
+
+                change = true;
+            }
+        }// end for (int cell = 0; cell < CELLS; cell++)
+
+        endPass(counters, STAGE_NAKED_SINGLES, started);
+
+
+        /// Numbers with only one potential square left in a unit. once holds
+        /// the numbers seen on at least one square of the unit and twice the
+        /// numbers seen on at least two.
+        started = startPass(counters);
+
+        for (int unit = 0; unit < UNITS; unit++)
+        {
+            unsigned short once = 0, twice = 0, placed = 0, single;
+
+            for (int i = 0; i < SIDE; i++)
+            {
+                int cell = unitCell(unit, i);
+
+                if (board.value[cell] != 0)
+                    placed |= digitBit(board.value[cell]);
+
+                twice |= once & board.cand[cell];
+                once |= board.cand[cell];
+            }
+
+            if ((once | placed) != ALL_DIGITS)
+            {
+                endPass(counters, STAGE_HIDDEN_SINGLES, started);
+                return false;
+            }
+
+            single = once & ~twice;
+
+            for (int i = 0; i < SIDE && single; i++)
+            {
+                int cell = unitCell(unit, i);
+                unsigned short here = board.cand[cell] & single;
+
+                if (here == 0)
+                    continue;
+
+                /// Two numbers that both need this square
+                if (countDigits(here) > 1)
+                {
+                    endPass(counters, STAGE_HIDDEN_SINGLES, started);
+                    return false;
+                }
+
+                place(cell, firstDigit(here));
+
+                trace.place(board, cell, firstDigit(here), HIDDEN_SINGLE);
+
+                addCount(counters, STAGE_HIDDEN_SINGLES, COUNT_PLACEMENTS);
+
+                single &= ~here;
+
+                change = true;
+            }
+
+        }// end for (int unit = 0; unit < UNITS; unit++)
+
+        endPass(counters, STAGE_HIDDEN_SINGLES, started);
+
+    }
+    while (change);
+
+    return true;
+}// end static bool singles(Board &board, Trace &trace, Trail *trail)
+
+
+
+/******************************************************************************/
+/**
+
+ Places every number logic alone can find, see singles(). The second form
+ logs every number placed on trail, so undoTrail() can take them back, even
+ after a contradiction.
+
+**/
+/******************************************************************************/
+
+
+
+template <class Trace>
+bool propagate(Board &board, Trace &trace)
+{
+    return singles(board, trace, (Trail *)NULL);
+}
+
+
+
+template <class Trace>
+bool propagate(Board &board, Trail &trail, Trace &trace)
+{
+    return singles(board, trace, &trail);
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Finds the empty square with the fewest potential numbers. Two is as few as
+ there can be after logic, so there is no need to look further once one is
+ found.
+
+**/
+/******************************************************************************/
+
+
+
+static int fewestCandidates(const Board &board)
+{
+    int best = -1, fewest = SIDE + 1;
+
+    for (int cell = 0; cell < CELLS && fewest > 2; cell++)
+    {
+        if (board.value[cell] == 0 && countDigits(board.cand[cell]) < fewest)
+        {
+            best = cell;
+            fewest = countDigits(board.cand[cell]);
+        }
+    }
+
+    return best;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Solves the board with logic, then guesses on the empty square with the
+ fewest potential numbers, trying its potential numbers from lowest to
+ highest. Every change is logged on trail, so going back to the last guess
+ only means undoing the trail to where it was, and no board is ever copied.
+ Returns true with the board solved, or false, with the board unchanged, if
+ there is no solution. depth is the number of guesses that led to this
+ board. Guesses and the ones that led
+ nowhere are counted in counters (counters.h), if counting, and spent from
+ budget, if there is one. Once the budget runs out the search unwinds
+ without finding anything, leaving the board from the top of the search
+ with what logic placed on it.
+
+**/
+/******************************************************************************/
+
+
+
+template <class Trace>
+static bool depthFirst(Board &board, Trail &trail, Trace &trace, int depth,
+                       ThreadCounters *counters, Budget *budget)
+{
+    int mark = trail.size, best;
+
+    if (!singles(board, trace, &trail))
+    {
+        undoTrail(board, trail, mark);
+        return false;
+    }
+
+    if (board.left == 0)
+        return true;
+
+
+    best = fewestCandidates(board);
+
+
+    /// Tries each potential number of that square in turn
+    for (unsigned short mask = board.cand[best]; mask; mask &= mask - 1)
+    {
+        int guessed = trail.size;
+
+        if (budget != NULL && !spendNode(*budget))
+            break;
+
+        placeDigit(board, trail, best, firstDigit(mask));
+
+        trace.guess(best, firstDigit(mask), depth + 1);
+
+        addCount(counters, STAGE_SEARCH, COUNT_GUESSES);
+
+        if (depthFirst(board, trail, trace, depth + 1, counters, budget))
+            return true;
+
+        undoTrail(board, trail, guessed);
+
+        addCount(counters, STAGE_SEARCH, COUNT_RESTARTS);
+
+        if (budget != NULL && !spendRestart(*budget))
+            break;
+    }
+
+    if (depth > 0 || budget == NULL || !budget->exhausted)
+        undoTrail(board, trail, mark);
+
+    return false;
+}// end static bool depthFirst(Board &board, Trail &trail, Trace &trace,
+//                              int depth, ThreadCounters *counters,
+//                              Budget *budget)
+
+
+
+/******************************************************************************/
+/**
+
+ Depth first search from the top, reporting every number placed and every
+ guess to trace.
+
+**/
+/******************************************************************************/
+
+
+
+template <class Trace>
+bool depthFirst(Board &board, Trace &trace)
+{
+    ThreadCounters *counters = stageCounters();
+    long started = startPass(counters);
+    Trail trail;
+    bool solved;
+
+    initTrail(trail);
+
+    solved = depthFirst(board, trail, trace, 0, counters, (Budget *)NULL);
+
+    endPass(counters, STAGE_SEARCH, started);
+
+    return solved;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Depth first search within budget. Returns SOLVE_SOLVED with the board
+ solved, SOLVE_UNSOLVABLE with the board unchanged, or SOLVE_EXHAUSTED with
+ the numbers logic placed before the first guess.
+
+**/
+/******************************************************************************/
+
+
+
+template <class Trace>
+SolveStatus depthFirst(Board &board, Trace &trace, Budget &budget)
+{
+    ThreadCounters *counters = stageCounters();
+    long started = startPass(counters);
+    Trail trail;
+    bool solved;
+
+    initTrail(trail);
+
+    solved = depthFirst(board, trail, trace, 0, counters, &budget);
+
+    endPass(counters, STAGE_SEARCH, started);
+
+    if (solved)
+        return SOLVE_SOLVED;
+
+    return budget.exhausted ? SOLVE_EXHAUSTED : SOLVE_UNSOLVABLE;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Adds the solutions found from this board on to count, searching the same
+ way depthFirst() does, on the trail, but going on after a solution instead
+ of stopping. The board is left as it was.
+ Gives up as soon as count reaches limit, or budget, if there is one, runs
+ out.
+
+**/
+/******************************************************************************/
+
+
+
+static void countFrom(Board &board, Trail &trail, int limit, int &count,
+                      Budget *budget)
+{
+    NullTrace trace;
+    int mark = trail.size, best;
+
+    if (!singles(board, trace, &trail))
+    {
+        undoTrail(board, trail, mark);
+        return;
+    }
+
+    if (board.left == 0)
+    {
+        count++;
+        undoTrail(board, trail, mark);
+        return;
+    }
+
+    best = fewestCandidates(board);
+
+    for (unsigned short mask = board.cand[best]; mask && count < limit;
+         mask &= mask - 1)
+    {
+        int guessed = trail.size;
+
+        if (budget != NULL && !spendNode(*budget))
+            break;
+
+        placeDigit(board, trail, best, firstDigit(mask));
+
+        countFrom(board, trail, limit, count, budget);
+
+        undoTrail(board, trail, guessed);
+    }
+
+    undoTrail(board, trail, mark);
+}// end static void countFrom(Board &board, Trail &trail, int limit,
+//                            int &count, Budget *budget)
+
+
+
+/******************************************************************************/
+/**
+
+ Counts the solutions of the board, stopping once limit of them have been
+ found. A limit of 2 is enough to tell whether a puzzle has no solution, one
+ solution or more than one. The board is left unchanged.
+
+**/
+/******************************************************************************/
+
+
+
+int countSolutions(const Board &board, int limit)
+{
+    Board search = board;
+    Trail trail;
+    int count = 0;
+
+    initTrail(trail);
+
+    if (limit > 0)
+        countFrom(search, trail, limit, count, NULL);
+
+    return count;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Counts solutions the same way within budget. If the budget runs out the
+ count is of the solutions found until then, and budget.exhausted is set.
+
+**/
+/******************************************************************************/
+
+
+
+int countSolutions(const Board &board, int limit, Budget &budget)
+{
+    Board search = board;
+    Trail trail;
+    int count = 0;
+
+    initTrail(trail);
+
+    if (limit > 0)
+        countFrom(search, trail, limit, count, &budget);
+
+    return count;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ propagate() and depthFirst() with nothing traced.
+
+**/
+/******************************************************************************/
+
+
+
+bool propagate(Board &board)
+{
+    NullTrace trace;
+
+    return propagate(board, trace);
+}
+
+
+
+bool propagate(Board &board, Trail &trail)
+{
+    NullTrace trace;
+
+    return propagate(board, trail, trace);
+}
+
+
+
+bool depthFirst(Board &board)
+{
+    NullTrace trace;
+
+    return depthFirst(board, trace);
+}
+
+
+
+SolveStatus depthFirst(Board &board, Budget &budget)
+{
+    NullTrace trace;
+
+    return depthFirst(board, trace, budget);
+}
+
+
+
+/// The sinks propagate() and depthFirst() can be used with
+template bool propagate(Board &, NullTrace &);
+template bool propagate(Board &, BoardTrace &);
+template bool propagate(Board &, TextTrace &);
+template bool propagate(Board &, BinaryTrace &);
+template bool propagate(Board &, CountTrace &);
+template bool propagate(Board &, Trail &, NullTrace &);
+template bool propagate(Board &, Trail &, BoardTrace &);
+template bool propagate(Board &, Trail &, TextTrace &);
+template bool propagate(Board &, Trail &, BinaryTrace &);
+template bool propagate(Board &, Trail &, CountTrace &);
+template bool depthFirst(Board &, NullTrace &);
+template bool depthFirst(Board &, BoardTrace &);
+template bool depthFirst(Board &, TextTrace &);
+template bool depthFirst(Board &, BinaryTrace &);
+template bool depthFirst(Board &, CountTrace &);
+template SolveStatus depthFirst(Board &, NullTrace &, Budget &);
+template SolveStatus depthFirst(Board &, BoardTrace &, Budget &);
+template SolveStatus depthFirst(Board &, TextTrace &, Budget &);
+template SolveStatus depthFirst(Board &, BinaryTrace &, Budget &);
+template SolveStatus depthFirst(Board &, CountTrace &, Budget &);
+
+
+
+/******************************************************************************/
+/**
+
+ Solves the array with depth first search. Returns true with the solution in
+ the array, or false, leaving the array unchanged, if the puzzle has no
+ solution.
+
+**/
+/******************************************************************************/
+
+
+
+bool depthFirst(int arr[][SIDE])
+{
+    Board board;
+
+    if (!initBoard(board, arr) || !depthFirst(board))
+        return false;
+
+    for (int cell = 0; cell < CELLS; cell++)
+        arr[rowOf(cell)][colOf(cell)] = board.value[cell];
+
+    return true;
+}// end bool depthFirst(int arr[][SIDE])
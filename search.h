@@ -0,0 +1,53 @@
+/**
+  Name: search.h
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Deterministic depth first search. Unlike bruteForce(), which
+  guesses at random and starts over from the first square on a dead end, the
+  search guesses on the square with the fewest potential numbers, applies the
+  same logic as solve() after every guess and goes back to the last guess when
+  it runs into a dead end. Every guess is tried at most once, so it always
+  finishes and can tell when a puzzle has no solution. Going back is done by
+  undoing a trail (board.h), so no board is copied along the way.
+
+  propagate() can log its placements on a trail too, so logic applied after
+  a single move can be taken back along with the move.
+
+  countSolutions() searches the whole tree instead of stopping at the first
+  solution, up to a limit, to tell whether a puzzle has a unique solution.
+
+  propagate() and depthFirst() report what they do to a trace sink
+  (trace.h), nothing by default.
+
+  depthFirst() and countSolutions() can be held to a budget (budget.h), so
+  they give up on a puzzle that takes too long.
+*/
+
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include "board.h"
+#include "budget.h"
+#include "trace.h"
+
+template <class Trace>
+bool propagate(Board &board, Trace &trace);
+bool propagate(Board &board);
+template <class Trace>
+bool propagate(Board &board, Trail &trail, Trace &trace);
+bool propagate(Board &board, Trail &trail);
+
+template <class Trace>
+bool depthFirst(Board &board, Trace &trace);
+bool depthFirst(Board &board);
+
+template <class Trace>
+SolveStatus depthFirst(Board &board, Trace &trace, Budget &budget);
+SolveStatus depthFirst(Board &board, Budget &budget);
+
+bool depthFirst(int arr[][SIDE]);
+int countSolutions(const Board &board, int limit);
+int countSolutions(const Board &board, int limit, Budget &budget);
+
+#endif // SEARCH_H
@@ -0,0 +1,633 @@
+/**
+  Name: server.cpp
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Solver daemon. See server.h.
+*/
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#if !defined(_WIN32)
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "corpus.h"
+#include "hint.h"
+#include "server.h"
+#include "sized.h"
+
+using namespace std;
+
+const size_t READ_BYTES = 64 * 1024;       // most read from a client at once
+
+/// Longest request worth reading: "HINT " and a 25x25 puzzle, then a
+/// carriage return. Anything longer is answered "line too long" and dropped
+/// rather than buffered.
+const size_t LONGEST_LINE = 5 + Geometry<5>::CELLS + 1;
+
+/// How often a connection waiting on its requests looks for the client
+/// having gone away
+const chrono::milliseconds HANGUP_CHECK(20);
+
+/// Where the reply to each request of a burst stands
+enum Slot { SLOT_WAITING, SLOT_READY, SLOT_STATS };
+
+
+
+/******************************************************************************/
+/**
+
+ Starts the solving threads, each with a solver of its own, and the cache if
+ cacheSize is above 0. threads is 0 for one per core. The performance
+ counters are turned on unless counters is COUNTERS_OFF. Every puzzle is
+ held to limits (budget.h). SIGPIPE is ignored from here on, so a client
+ or reader that goes away mid reply, on a socket or on standard output,
+ makes the write fail instead of killing the server.
+
+**/
+/******************************************************************************/
+
+
+
+void startServer(Server &server, Engine engine, int threads,
+                 size_t cacheSize, CounterFormat counters,
+                 const Budget &limits)
+{
+    if (threads <= 0)
+        threads = defaultThreads();
+
+#if !defined(_WIN32)
+    signal(SIGPIPE, SIG_IGN);
+#endif
+
+    server.counters = counters;
+
+    if (counters != COUNTERS_OFF)
+        startCounters();
+
+    initCache(server.cache, cacheSize);
+
+    for (int i = 0; i < threads; i++)
+    {
+        server.solvers.push_back(new Solver);
+        initSolver(*server.solvers[i], engine);
+
+        server.solvers[i]->budget = limits;
+
+        if (cacheSize > 0)
+            server.solvers[i]->cache = &server.cache;
+    }
+
+    startPool(server.pool, threads);
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Stops the solving threads and frees the solvers.
+
+**/
+/******************************************************************************/
+
+
+
+void stopServer(Server &server)
+{
+    stopPool(server.pool);
+
+    for (size_t i = 0; i < server.solvers.size(); i++)
+        delete server.solvers[i];
+
+    server.solvers.clear();
+}
+
+
+
+/// The reply to a puzzle that was solved, has no solution or ran out of
+/// budget, with the board as it was left, size squares long
+static string replyFor(SolveStatus status, const char *board, size_t size)
+{
+    if (status == SOLVE_SOLVED)
+        return to_string(REPLY_SOLVED) + ' ' + string(board, size);
+
+    if (status == SOLVE_EXHAUSTED)
+        return to_string(REPLY_EXHAUSTED) + ' ' + string(board, size);
+
+    return to_string(REPLY_UNSOLVABLE) + " no solution";
+}
+
+
+
+/// Replies to a puzzle of box order N other than 9x9 (sized.h), within
+/// budget
+template <int N>
+static void answerSized(const char *line, size_t length, Budget &budget,
+                        string &reply)
+{
+    int values[Geometry<N>::CELLS];
+    char solution[Geometry<N>::CELLS];
+    SizedBoard<N> board;
+    SolveStatus status = SOLVE_UNSOLVABLE;
+    string error;
+
+    if (!parseSized<N>(line, length, values, error))
+    {
+        reply = to_string(REPLY_MALFORMED) + ' ' + error;
+        return;
+    }
+
+    if (initBoard(board, values))
+    {
+        startBudget(budget);
+        status = depthFirst(board, budget);
+    }
+
+    writeSized(board, solution);
+    reply = replyFor(status, solution, Geometry<N>::CELLS);
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Answers HINT with the next step logic can take on the board that follows
+ it, as written by writeHint() (hint.h).
+
+**/
+/******************************************************************************/
+
+
+
+static void answerHint(const char *line, size_t length, string &reply)
+{
+    int arr[SIDE][SIDE];
+    string error;
+    Game game;
+    Hint hint;
+
+    if (!parsePuzzle(line, length, arr, error))
+        reply = to_string(REPLY_MALFORMED) + ' ' + error;
+    else if (!startGame(game, arr) || !nextHint(game, hint))
+        reply = to_string(REPLY_UNSOLVABLE) + " no hint";
+    else
+    {
+        reply = to_string(REPLY_SOLVED) + ' ';
+        writeHint(hint, reply);
+    }
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Works out the reply to one request line, length long without its newline,
+ using solver: a status code and what goes with it (see server.h). QUIT is
+ left to serveStream().
+
+**/
+/******************************************************************************/
+
+
+
+void answerRequest(Solver &solver, const char *line, size_t length,
+                   string &reply)
+{
+    int arr[SIDE][SIDE], order;
+    char solution[CELLS];
+    Board board;
+    SolveStatus status;
+    string error;
+    bool hit;
+
+    while (length > 0 && (line[length - 1] == ' ' || line[length - 1] == '\t' ||
+                          line[length - 1] == '\r'))
+        length--;
+
+    order = puzzleOrder(line, length);
+
+    if (order == 2)
+        answerSized<2>(line, length, solver.budget, reply);
+    else if (order == 4)
+        answerSized<4>(line, length, solver.budget, reply);
+    else if (order == 5)
+        answerSized<5>(line, length, solver.budget, reply);
+    else if (length == 4 && memcmp(line, "PING", 4) == 0)
+        reply = to_string(REPLY_SOLVED) + " PONG";
+    else if (length > 5 && memcmp(line, "HINT ", 5) == 0)
+        answerHint(line + 5, length - 5, reply);
+    else if (order == 0 && length > 0 && line[0] >= 'A' && line[0] <= 'Z')
+        reply = to_string(REPLY_UNKNOWN) + " unknown command " +
+                string(line, length);
+    else if (!parsePuzzle(line, length, arr, error))
+        reply = to_string(REPLY_MALFORMED) + ' ' + error;
+    else
+    {
+        status = solveArray(solver, arr, board, hit);
+
+        writeBoard(board, solution);
+        reply = replyFor(status, solution, CELLS);
+    }
+}// end void answerRequest(Solver &solver, const char *line, size_t length,
+//                        string &reply)
+
+
+
+/******************************************************************************/
+/**
+
+ Answers STATS with the counters of every solving thread so far, in the
+ server's format, or "3 counters are off".
+
+**/
+/******************************************************************************/
+
+
+
+static void answerStats(const Server &server, string &reply)
+{
+    if (server.counters == COUNTERS_OFF)
+    {
+        reply = to_string(REPLY_UNKNOWN) + " counters are off";
+        return;
+    }
+
+    if (server.counters == COUNTERS_JSON)
+        reply = to_string(REPLY_SOLVED) + ' ';
+    else
+        reply = to_string(REPLY_SOLVED) + " prometheus\n";
+
+    writeCounters(server.counters, reply);
+
+    if (server.counters == COUNTERS_PROMETHEUS)
+        reply += "# EOF";
+}
+
+
+
+#if !defined(_WIN32)
+
+/// Writes all of data to fd, returning false if it cannot
+static bool writeAll(int fd, const char *data, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t written = write(fd, data, size);
+
+        if (written < 0 && errno == EINTR)
+            continue;
+
+        if (written <= 0)
+            return false;
+
+        data += written;
+        size -= size_t(written);
+    }
+
+    return true;
+}
+
+
+
+/// Whether whoever reads fd has gone away. A client that has only shut down
+/// its own sending side still reads its replies, so that is not enough.
+static bool hungUp(int fd)
+{
+    struct pollfd watch;
+
+    watch.fd = fd;
+    watch.events = 0;
+    watch.revents = 0;
+
+    return poll(&watch, 1, 0) > 0 && (watch.revents & (POLLHUP | POLLERR));
+}
+
+#endif
+
+
+
+/******************************************************************************/
+/**
+
+ Answers requests read from the file descriptor in, writing the replies to
+ out, until in is closed or a QUIT comes. Every whole line that has arrived
+ is handed to the solving threads at once, and each reply is written as
+ soon as it and every reply before it are ready, so a slow puzzle only
+ holds back the replies after it. STATS is answered when its turn to be
+ written comes, so it takes in the requests before it. The next read waits
+ until the whole burst is answered. Returns false if a reply could not be
+ written.
+
+ A line longer than LONGEST_LINE is answered "2 line too long" without
+ being kept: what has come of it is dropped, and so is the rest as it comes.
+
+ Each request's budget holds the connection's cancel flag. If the client
+ goes away while its requests are being solved, the flag is set, so they
+ stop at once instead of holding up the solving threads to no end.
+
+**/
+/******************************************************************************/
+
+
+
+bool serveStream(Server &server, int in, int out)
+{
+#if defined(_WIN32)
+    (void)server;
+    (void)in;
+    (void)out;
+
+    cerr << "the server needs a POSIX system" << endl;
+
+    return false;
+#else
+    vector<pair<size_t, size_t> > lines;
+    vector<char> slots;
+    vector<string> replies;
+    string pending, output;
+    char buffer[READ_BYTES];
+    mutex doneLock;
+    condition_variable doneWake;
+    atomic<bool> cancel(false);
+    bool quit = false, closed = false, skipping = false;
+
+    while (!quit && !closed)
+    {
+        ssize_t got = read(in, buffer, sizeof buffer);
+        size_t start = 0, newline, last, written = 0;
+        long submitted = 0, done = 0;
+        bool failed = false;
+
+        if (got < 0 && errno == EINTR)
+            continue;
+
+
+        /// A last line with no newline is still a request
+        if (got <= 0)
+        {
+            closed = true;
+
+            if (pending.empty())
+                break;
+
+            pending += '\n';
+        }
+        else if (skipping)
+        {
+            const char *end = (const char *)memchr(buffer, '\n', size_t(got));
+
+            if (end == NULL)
+                continue;
+
+            skipping = false;
+            pending.append(end + 1, buffer + got - (end + 1));
+        }
+        else
+            pending.append(buffer, size_t(got));
+
+        lines.clear();
+
+        while ((newline = pending.find('\n', start)) != string::npos)
+        {
+            lines.push_back(make_pair(start, newline - start));
+            start = newline + 1;
+        }
+
+        replies.assign(lines.size(), string());
+        slots.assign(lines.size(), char(SLOT_READY));
+        last = lines.size();
+
+        for (size_t i = 0; i < lines.size(); i++)
+        {
+            const char *line = pending.data() + lines[i].first;
+            size_t length = lines[i].second;
+
+            if (length > 0 && line[length - 1] == '\r')
+                length--;
+
+            if (length == 0)
+                continue;
+
+            if (length > LONGEST_LINE)
+            {
+                replies[i] = to_string(REPLY_MALFORMED) + " line too long";
+                continue;
+            }
+
+            if (length == 4 && memcmp(line, "QUIT", 4) == 0)
+            {
+                quit = true;
+                last = i;
+                break;
+            }
+
+            if (length == 5 && memcmp(line, "STATS", 5) == 0)
+            {
+                slots[i] = SLOT_STATS;
+                continue;
+            }
+
+            slots[i] = SLOT_WAITING;
+
+            submit(server.pool, [&, line, length, i](int worker)
+            {
+                Solver &solver = *server.solvers[worker];
+
+                solver.budget.cancel = &cancel;
+
+                answerRequest(solver, line, length, replies[i]);
+
+                solver.budget.cancel = NULL;
+
+                lock_guard<mutex> guard(doneLock);
+                slots[i] = SLOT_READY;
+                done++;
+                doneWake.notify_one();
+            });
+
+            submitted++;
+
+        }// end for (size_t i = 0; i < lines.size(); i++)
+
+
+        /// Writes the replies as they come ready, in order. The solving
+        /// threads hold on to the burst's lines and replies, so they are
+        /// waited for even if the client has gone.
+        while (written < last)
+        {
+            size_t ready = written;
+
+            {
+                unique_lock<mutex> guard(doneLock);
+
+                if (!doneWake.wait_for(guard, HANGUP_CHECK, [&]
+                    { return slots[written] != SLOT_WAITING; }))
+                {
+                    if (hungUp(out))
+                        cancel.store(true, memory_order_relaxed);
+
+                    continue;
+                }
+
+                while (ready < last && slots[ready] != SLOT_WAITING)
+                    ready++;
+            }
+
+            if (cancel.load(memory_order_relaxed))
+            {
+                failed = true;
+                break;
+            }
+
+            output.clear();
+
+            for (; written < ready; written++)
+            {
+                string &reply = replies[written];
+
+                if (slots[written] == SLOT_STATS)
+                    answerStats(server, reply);
+
+                if (!reply.empty())
+                {
+                    output += reply;
+                    output += '\n';
+                }
+            }
+
+            if (!writeAll(out, output.data(), output.size()))
+            {
+                cancel.store(true, memory_order_relaxed);
+                failed = true;
+                break;
+            }
+
+        }// end while (written < last)
+
+        {
+            unique_lock<mutex> guard(doneLock);
+
+            doneWake.wait(guard, [&] { return done == submitted; });
+        }
+
+        if (failed)
+            return false;
+
+        output.clear();
+
+        pending.erase(0, start);
+
+
+        /// A line already too long is answered now, and the rest of it
+        /// skipped up to its newline
+        if (!quit && pending.size() > LONGEST_LINE)
+        {
+            output += to_string(REPLY_MALFORMED) + " line too long\n";
+            pending.clear();
+            skipping = true;
+        }
+
+        if (!writeAll(out, output.data(), output.size()))
+            return false;
+
+    }// end while (!quit && !closed)
+
+    return true;
+#endif
+}// end bool serveStream(Server &server, int in, int out)
+
+
+
+/******************************************************************************/
+/**
+
+ Listens on a Unix domain socket at path, replacing anything already there,
+ and serves every connection with serveStream() on a thread of its own.
+ Only returns, false, if the socket cannot be set up or stops accepting.
+
+**/
+/******************************************************************************/
+
+
+
+bool serveSocket(Server &server, const char *path)
+{
+#if defined(_WIN32)
+    (void)server;
+    (void)path;
+
+    cerr << "the server needs a POSIX system" << endl;
+
+    return false;
+#else
+    struct sockaddr_un address;
+    int listener;
+
+    if (strlen(path) >= sizeof address.sun_path)
+    {
+        cerr << "socket path too long: " << path << endl;
+        return false;
+    }
+
+    memset(&address, 0, sizeof address);
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path);
+
+    listener = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    unlink(path);
+
+    if (listener < 0 ||
+        bind(listener, (struct sockaddr *)&address, sizeof address) != 0 ||
+        listen(listener, SOMAXCONN) != 0)
+    {
+        cerr << "unable to listen on " << path << ": " << strerror(errno)
+             << endl;
+
+        if (listener >= 0)
+            close(listener);
+
+        return false;
+    }
+
+    for (;;)
+    {
+        int client = accept(listener, NULL, NULL);
+
+        if (client < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+
+            cerr << "accept failed: " << strerror(errno) << endl;
+            break;
+        }
+
+        thread([&server, client]
+        {
+            serveStream(server, client, client);
+            close(client);
+        }).detach();
+    }
+
+    close(listener);
+
+    return false;
+#endif
+}// end bool serveSocket(Server &server, const char *path)
@@ -0,0 +1,87 @@
+/**
+  Name: server.h
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Solver daemon. Stays running and answers puzzles sent to it
+  over a Unix domain socket, or over standard input and output, so a caller
+  does not pay for starting a process for every puzzle.
+
+  Requests are lines: a puzzle in the one per line format (corpus.h, and the
+  other sizes of sized.h), or a command. Each request gets one line back, in
+  the order the requests came in, starting with a status code:
+
+    0 <solution>          solved
+    1 no solution         the puzzle has no solution
+    2 <reason>            the line is not a puzzle
+    3 <reason>            unknown command
+    4 <board>             out of budget (budget.h), with the squares logic
+                          filled in and '.' for the rest
+
+  HINT followed by a 9x9 board answers with the next step logic can take on
+  it, e.g. "0 r3c5=7 hidden single: r1c4 r2c9 r5c6" (hint.h), or with "1 no
+  hint" if logic finds none. The server keeps no game between requests, so
+  each board is worked out afresh; a client that links hint.cpp keeps it.
+
+  The other commands are PING, answered "0 PONG", QUIT, which closes the
+  connection once the replies before it are written, and STATS, which answers
+  with the performance counters of every solving thread so far (counters.h),
+  once the requests before it are answered. In JSON the counters follow the
+  0 on the same line; as Prometheus text the reply is "0 prometheus", then
+  the counters, then "# EOF". STATS is answered "3 counters are off" unless
+  the server was started with a format. Empty lines are ignored. A line
+  longer than any request can be ("HINT " and a 25x25 puzzle) is answered
+  "2 line too long" and dropped as it comes, so the server never holds more
+  than one request's worth of a line that has no end.
+
+  A client can send any number of requests before it reads the replies.
+  Whatever has arrived is solved at once on a fixed pool of threads, each
+  with a solver of its own allocated when the server starts (batch.h), and
+  each reply is written back as soon as it and the replies before it are
+  ready. A slow puzzle still holds back the replies after it, since they
+  keep the order of the requests, and the connection reads nothing more
+  until everything that had arrived is answered. Each connection to the
+  socket is read by a thread of its own; the solving threads are shared. A
+  client that hangs up while its requests are being solved cancels them
+  (budget.h).
+
+  client.cpp is a small test client for the socket.
+*/
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <string>
+#include <vector>
+
+#include "batch.h"
+#include "counters.h"
+#include "pool.h"
+
+enum ReplyStatus
+{
+    REPLY_SOLVED,
+    REPLY_UNSOLVABLE,
+    REPLY_MALFORMED,
+    REPLY_UNKNOWN,
+    REPLY_EXHAUSTED
+};
+
+struct Server
+{
+    WorkPool pool;
+    std::vector<Solver *> solvers;  // one per thread in pool
+    SolutionCache cache;
+    CounterFormat counters;         // how STATS answers, if at all
+};
+
+void startServer(Server &server, Engine engine, int threads,
+                 size_t cacheSize, CounterFormat counters,
+                 const Budget &limits);
+void stopServer(Server &server);
+void answerRequest(Solver &solver, const char *line, size_t length,
+                   std::string &reply);
+bool serveStream(Server &server, int in, int out);
+bool serveSocket(Server &server, const char *path);
+
+#endif // SERVER_H
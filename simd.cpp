@@ -0,0 +1,435 @@
+/**
+  Name: simd.cpp
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Lockstep logic for 16 boards at once. See simd.h.
+*/
+
+#include <cstring>
+
+#include "search.h"
+#include "simd.h"
+
+/// GCC and Clang can compile one function for AVX2 and pick it at run time
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LOCKSTEP_AVX2
+#endif
+
+#if defined(__GNUC__)
+
+/// Lanes are only ever passed between functions that are inlined into each
+/// other, so the ABI warning about passing them without AVX does not apply
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+/// One square, or one mask, on all 16 boards
+typedef unsigned short Lanes __attribute__((vector_size(2 * LANES)));
+
+#define LANE_INLINE inline __attribute__((always_inline))
+
+#define lanesEqual(a, b) ((Lanes)((a) == (b)))
+
+#else
+
+struct Lanes
+{
+    unsigned short lane[LANES];
+
+    unsigned short &operator[](int l) { return lane[l]; }
+    unsigned short operator[](int l) const { return lane[l]; }
+};
+
+#define LANE_INLINE inline
+
+static inline Lanes operator&(Lanes a, Lanes b)
+{
+    for (int l = 0; l < LANES; l++)
+        a.lane[l] &= b.lane[l];
+
+    return a;
+}
+
+static inline Lanes operator|(Lanes a, Lanes b)
+{
+    for (int l = 0; l < LANES; l++)
+        a.lane[l] |= b.lane[l];
+
+    return a;
+}
+
+static inline Lanes operator-(Lanes a, Lanes b)
+{
+    for (int l = 0; l < LANES; l++)
+        a.lane[l] -= b.lane[l];
+
+    return a;
+}
+
+static inline Lanes operator~(Lanes a)
+{
+    for (int l = 0; l < LANES; l++)
+        a.lane[l] = ~a.lane[l];
+
+    return a;
+}
+
+static inline Lanes &operator&=(Lanes &a, Lanes b) { return a = a & b; }
+static inline Lanes &operator|=(Lanes &a, Lanes b) { return a = a | b; }
+
+static inline Lanes lanesEqual(Lanes a, Lanes b)
+{
+    for (int l = 0; l < LANES; l++)
+        a.lane[l] = a.lane[l] == b.lane[l] ? 0xFFFF : 0;
+
+    return a;
+}
+
+#endif // __GNUC__
+
+/// The 16 boards, structure of arrays
+struct LaneBoards
+{
+    Lanes cand[CELLS];              // potential numbers, one bit once filled
+    Lanes done[CELLS];              // all ones where the number was used
+    Lanes dead;                     // all ones for a board with no solution
+};
+
+
+
+static LANE_INLINE Lanes splat(unsigned short value)
+{
+    Lanes lanes;
+
+    for (int l = 0; l < LANES; l++)
+        lanes[l] = value;
+
+    return lanes;
+}
+
+
+
+/// True if any board has a bit set
+static LANE_INLINE bool anyLane(const Lanes &lanes)
+{
+    unsigned long long words[sizeof(Lanes) / 8];
+
+    memcpy(words, &lanes, sizeof(Lanes));
+
+    unsigned long long any = 0;
+
+    for (size_t i = 0; i < sizeof(Lanes) / 8; i++)
+        any |= words[i];
+
+    return any != 0;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Naked and hidden singles on every board until no board that still has a
+ chance changes.
+
+ A naked single is a square left with one bit that has not yet been taken
+ out of its peers. A hidden single is a bit found on only one square of a
+ unit; that square is cut down to it. A board is dead once a square has no
+ bits left or a unit is missing a number altogether.
+
+ Every step works on a whole Lanes at once, so the same code runs for all 16
+ boards and a board with nothing to do simply sees its masks unchanged.
+
+**/
+/******************************************************************************/
+
+
+
+static LANE_INLINE void lockstep(LaneBoards &lanes)
+{
+    const Lanes zero = splat(0), one = splat(1), all = splat(ALL_DIGITS);
+    bool changed = true;
+
+    while (changed)
+    {
+        Lanes progress = zero;
+
+
+        /// Naked singles: takes every newly single bit out of the peers
+        for (int cell = 0; cell < CELLS; cell++)
+        {
+            Lanes cand = lanes.cand[cell];
+            Lanes empty = lanesEqual(cand, zero);
+            Lanes single = lanesEqual(cand & (cand - one), zero) & ~empty &
+                           ~lanes.done[cell];
+
+            lanes.dead |= empty;
+
+            if (!anyLane(single))
+                continue;
+
+            Lanes keep = ~(cand & single);
+
+            for (int p = 0; p < PEERS; p++)
+                lanes.cand[peerCell(cell, p)] &= keep;
+
+            lanes.done[cell] |= single;
+            progress |= single;
+        }
+
+
+        /// Hidden singles: bits seen once in a unit
+        for (int unit = 0; unit < UNITS; unit++)
+        {
+            Lanes once = zero, twice = zero;
+
+            for (int i = 0; i < SIDE; i++)
+            {
+                Lanes cand = lanes.cand[unitCell(unit, i)];
+
+                twice |= once & cand;
+                once |= cand;
+            }
+
+            lanes.dead |= ~lanesEqual(once, all);
+
+            Lanes hidden = once & ~twice;
+
+            if (!anyLane(hidden))
+                continue;
+
+            for (int i = 0; i < SIDE; i++)
+            {
+                int cell = unitCell(unit, i);
+                Lanes cand = lanes.cand[cell];
+                Lanes found = cand & hidden;
+                Lanes cut = ~lanesEqual(found, zero) &
+                            ~lanesEqual(found, cand);
+
+                lanes.cand[cell] = (cand & ~cut) | (found & cut);
+                progress |= cut;
+            }
+        }
+
+        changed = anyLane(progress & ~lanes.dead);
+
+    }// end while (changed)
+
+}// end static void lockstep(LaneBoards &lanes)
+
+
+
+static void lockstepDefault(LaneBoards &lanes)
+{
+    lockstep(lanes);
+}
+
+#if defined(LOCKSTEP_AVX2)
+
+__attribute__((target("avx2")))
+static void lockstepAvx2(LaneBoards &lanes)
+{
+    lockstep(lanes);
+}
+
+#endif
+
+
+
+/******************************************************************************/
+/**
+
+ Picks the AVX2 version if this CPU has AVX2.
+
+**/
+/******************************************************************************/
+
+
+
+typedef void (*LockstepKernel)(LaneBoards &);
+
+static LockstepKernel pickKernel()
+{
+#if defined(LOCKSTEP_AVX2)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2"))
+        return lockstepAvx2;
+#endif
+
+    return lockstepDefault;
+}
+
+
+
+static LockstepKernel kernel()
+{
+    static const LockstepKernel picked = pickKernel();
+
+    return picked;
+}
+
+
+
+/// Name of the instruction set the lockstep logic runs on
+const char *lockstepTarget()
+{
+#if defined(LOCKSTEP_AVX2)
+    if (kernel() == lockstepAvx2)
+        return "avx2";
+#endif
+
+    return "default";
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Runs naked and hidden singles on count boards (at most LANES) at once. Each
+ board comes back with what was placed and a status: solved, unsolvable, or
+ stuck if it needs a search to finish.
+
+**/
+/******************************************************************************/
+
+
+
+void propagateLanes(Board boards[], int count, LaneStatus status[])
+{
+    LaneBoards lanes;
+    int arr[SIDE][SIDE];
+
+
+    /// Unused lanes are left with no potential numbers, so they die at once
+    /// and do not hold the others up
+    for (int cell = 0; cell < CELLS; cell++)
+    {
+        for (int l = 0; l < LANES; l++)
+        {
+            unsigned short cand = 0, done = 0xFFFF;
+
+            if (l < count && boards[l].value[cell] != 0)
+                cand = digitBit(boards[l].value[cell]);
+            else if (l < count)
+            {
+                cand = boards[l].cand[cell];
+                done = 0;
+            }
+
+            lanes.cand[cell][l] = cand;
+            lanes.done[cell][l] = done;
+        }
+    }
+
+    lanes.dead = splat(0);
+
+    kernel()(lanes);
+
+
+    /// Stuck boards keep the potential numbers the lanes cut down, not just
+    /// the numbers placed
+    for (int l = 0; l < count; l++)
+    {
+        bool solved = true;
+
+        if (lanes.dead[l])
+        {
+            status[l] = LANE_UNSOLVABLE;
+            continue;
+        }
+
+        for (int cell = 0; cell < CELLS; cell++)
+        {
+            unsigned short cand = lanes.cand[cell][l];
+
+            if (countDigits(cand) == 1)
+                arr[rowOf(cell)][colOf(cell)] = firstDigit(cand);
+            else
+            {
+                arr[rowOf(cell)][colOf(cell)] = 0;
+                solved = false;
+            }
+        }
+
+        initBoard(boards[l], arr);
+
+        for (int cell = 0; cell < CELLS; cell++)
+        {
+            unsigned short cut = boards[l].cand[cell] & ~lanes.cand[cell][l];
+
+            for (; boards[l].value[cell] == 0 && cut != 0; cut &= cut - 1)
+                removeDigit(boards[l], cell, firstDigit(cut));
+        }
+
+        status[l] = solved ? LANE_SOLVED : LANE_STUCK;
+
+    }// end for (int l = 0; l < count; l++)
+
+}// end void propagateLanes(Board boards[], int count, LaneStatus status[])
+
+
+
+/******************************************************************************/
+/**
+
+ Solves count boards (at most LANES): the lockstep logic first, then
+ depthFirst() for each board it could not finish. solved[l] is false for a
+ board with no solution.
+
+**/
+/******************************************************************************/
+
+
+
+void solveLanes(Board boards[], int count, bool solved[])
+{
+    LaneStatus status[LANES];
+
+    propagateLanes(boards, count, status);
+
+    for (int l = 0; l < count; l++)
+    {
+        if (status[l] == LANE_STUCK)
+            solved[l] = depthFirst(boards[l]);
+        else
+            solved[l] = status[l] == LANE_SOLVED;
+    }
+}
+
+
+
+/******************************************************************************/
+/**
+
+ The same, but each board the lockstep logic could not finish is searched
+ within a fresh start of budget, so a hard board, or a cancel, stops its
+ search with SOLVE_EXHAUSTED and what it found so far instead of holding up
+ the rest. The lockstep logic itself makes no guesses and is not budgeted.
+
+**/
+/******************************************************************************/
+
+
+
+void solveLanes(Board boards[], int count, SolveStatus status[],
+                Budget &budget)
+{
+    LaneStatus lane[LANES];
+
+    propagateLanes(boards, count, lane);
+
+    for (int l = 0; l < count; l++)
+    {
+        if (lane[l] == LANE_STUCK)
+        {
+            startBudget(budget);
+            status[l] = depthFirst(boards[l], budget);
+        }
+        else if (lane[l] == LANE_SOLVED)
+            status[l] = SOLVE_SOLVED;
+        else
+            status[l] = SOLVE_UNSOLVABLE;
+    }
+}// end void solveLanes(Board boards[], int count, SolveStatus status[],
+//                      Budget &budget)
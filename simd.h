@@ -0,0 +1,36 @@
+/**
+  Name: simd.h
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Lockstep logic for 16 boards at once. The potential numbers of
+  the same square on 16 different boards sit next to each other in memory, so
+  one 256 bit vector instruction works on that square for all 16 boards.
+  Naked and hidden singles run on all the boards together until none of them
+  changes; boards that are solved or shown to have no solution are done, and
+  the rest go on to depthFirst() one at a time, each within a fresh start of
+  the budget (budget.h) if one is given.
+
+  The vector code is compiled twice, once for AVX2 and once for whatever the
+  compiler targets by default, and the AVX2 version is only used if the CPU
+  running the program has it. Compilers without GCC style vector extensions
+  get plain loops over the 16 boards instead.
+*/
+
+#ifndef SIMD_H
+#define SIMD_H
+
+#include "board.h"
+#include "budget.h"
+
+const int LANES = 16;                       // boards worked on together
+
+enum LaneStatus { LANE_SOLVED, LANE_STUCK, LANE_UNSOLVABLE };
+
+const char *lockstepTarget();
+void propagateLanes(Board boards[], int count, LaneStatus status[]);
+void solveLanes(Board boards[], int count, bool solved[]);
+void solveLanes(Board boards[], int count, SolveStatus status[],
+                Budget &budget);
+
+#endif // SIMD_H
@@ -0,0 +1,700 @@
+/**
+  Name: sized.cpp
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Boards of any size. See sized.h.
+*/
+
+#include "sized.h"
+
+using namespace std;
+
+
+
+/// Number of potential numbers in a mask
+static inline int maskCount(uint32_t mask)
+{
+#if defined(__GNUC__)
+    return __builtin_popcount(mask);
+#else
+    int count = 0;
+
+    for (; mask; mask &= mask - 1)
+        count++;
+
+    return count;
+#endif
+}
+
+
+
+/// Lowest number in a mask, 0 if the mask is empty
+static inline int maskFirst(uint32_t mask)
+{
+#if defined(__GNUC__)
+    return mask ? __builtin_ctz(mask) + 1 : 0;
+#else
+    for (int d = 1; d <= 32; d++)
+        if (mask & (1u << (d - 1)))
+            return d;
+
+    return 0;
+#endif
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Works out the box order of a puzzle line from its length, ignoring trailing
+ spaces, tabs and carriage returns: 16 squares is 2, 81 is 3, 256 is 4 and
+ 625 is 5. Returns 0 for any other length.
+
+**/
+/******************************************************************************/
+
+
+
+int puzzleOrder(const char *text, size_t length)
+{
+    while (length > 0 && (text[length - 1] == ' ' || text[length - 1] == '\t' ||
+                          text[length - 1] == '\r'))
+        length--;
+
+    for (int n = 2; n <= 5; n++)
+        if (length == size_t(n * n * n * n))
+            return n;
+
+    return 0;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Fills values from one line of text, the same way parsePuzzle() does for
+ 9x9 (corpus.h). Returns false with the reason in error if the line is the
+ wrong length or has a character that is not a number of this size, '0' or
+ '.'. Whether the numbers clash is left to initBoard().
+
+**/
+/******************************************************************************/
+
+
+
+template <int N>
+bool parseSized(const char *text, size_t length, int values[], string &error)
+{
+    typedef Geometry<N> G;
+
+    while (length > 0 && (text[length - 1] == ' ' || text[length - 1] == '\t' ||
+                          text[length - 1] == '\r'))
+        length--;
+
+    if (length != size_t(G::CELLS))
+    {
+        error = "expected " + to_string(G::CELLS) + " squares, found " +
+                to_string(length);
+        return false;
+    }
+
+    for (int cell = 0; cell < G::CELLS; cell++)
+    {
+        char c = text[cell];
+        int value = -1;
+
+        if (c == '0' || c == '.')
+            value = 0;
+        else if (c >= '1' && c <= '9')
+            value = c - '0';
+        else if (c >= 'A' && c <= 'Z')
+            value = c - 'A' + 10;
+        else if (c >= 'a' && c <= 'z')
+            value = c - 'a' + 10;
+
+        if (value < 0 || value > G::SIDE)
+        {
+            error = "invalid character '" + string(1, c) + "' at square " +
+                    to_string(cell + 1);
+            return false;
+        }
+
+        values[cell] = value;
+
+    }// end for (int cell = 0; cell < G::CELLS; cell++)
+
+    return true;
+}// end bool parseSized(const char *text, size_t length, int values[],
+//                     string &error)
+
+
+
+/******************************************************************************/
+/**
+
+ Writes the board as N^4 characters to out, '.' for an empty square. No
+ newline or terminating zero is added.
+
+**/
+/******************************************************************************/
+
+
+
+template <int N>
+void writeSized(const SizedBoard<N> &board, char *out)
+{
+    for (int cell = 0; cell < Geometry<N>::CELLS; cell++)
+    {
+        int value = board.value[cell];
+
+        if (value == 0)
+            out[cell] = '.';
+        else if (value <= 9)
+            out[cell] = char('0' + value);
+        else
+            out[cell] = char('A' + value - 10);
+    }
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Fills the board from values, zeros being empty squares, and gives every
+ empty square the numbers not yet used by its row, column or grid as its
+ potential numbers. Returns false if the same number appears twice in a
+ unit.
+
+**/
+/******************************************************************************/
+
+
+
+template <int N>
+bool initBoard(SizedBoard<N> &board, const int values[])
+{
+    typedef Geometry<N> G;
+    typedef typename G::Mask Mask;
+
+    const Tables<N> &tables = Lookup<N>::tables;
+    bool valid = true;
+
+    board.left = 0;
+
+    for (int cell = 0; cell < G::CELLS; cell++)
+    {
+        board.value[cell] = (unsigned char)values[cell];
+        board.cand[cell] = values[cell] == 0 ? G::ALL : 0;
+
+        if (values[cell] == 0)
+            board.left++;
+    }
+
+
+    /// Takes every number on the board off its peers
+    for (int cell = 0; cell < G::CELLS; cell++)
+    {
+        if (values[cell] == 0)
+            continue;
+
+        Mask bit = Mask(1u << (values[cell] - 1));
+
+        for (int p = 0; p < G::PEERS; p++)
+        {
+            int peer = tables.peer[cell][p];
+
+            if (values[peer] == values[cell])
+                valid = false;
+
+            board.cand[peer] &= Mask(~bit);
+        }
+    }
+
+    return valid;
+}// end bool initBoard(SizedBoard<N> &board, const int values[])
+
+
+
+/******************************************************************************/
+/**
+
+ Places digit on an empty square and takes it off every peer. Returns false,
+ without changing anything, if digit is not a potential number of the
+ square.
+
+**/
+/******************************************************************************/
+
+
+
+template <int N>
+bool placeDigit(SizedBoard<N> &board, int cell, int digit)
+{
+    typedef Geometry<N> G;
+    typedef typename G::Mask Mask;
+
+    const Tables<N> &tables = Lookup<N>::tables;
+    Mask clear = Mask(~(1u << (digit - 1)));
+
+    if (!(board.cand[cell] & ~clear))
+        return false;
+
+    board.value[cell] = (unsigned char)digit;
+    board.cand[cell] = 0;
+    board.left--;
+
+    for (int p = 0; p < G::PEERS; p++)
+        board.cand[tables.peer[cell][p]] &= clear;
+
+    return true;
+}// end bool placeDigit(SizedBoard<N> &board, int cell, int digit)
+
+
+
+/******************************************************************************/
+/**
+
+ Places digit the same way, logging the placement on trail: the square's
+ potential numbers and which of its peers lose digit, so undoTrail() can put
+ them back. Returns false, logging nothing, if digit is not a potential
+ number of the square.
+
+**/
+/******************************************************************************/
+
+
+
+template <int N>
+bool placeDigit(SizedBoard<N> &board, SizedTrail<N> &trail, int cell,
+                int digit)
+{
+    typedef Geometry<N> G;
+    typedef typename G::Mask Mask;
+
+    const Tables<N> &tables = Lookup<N>::tables;
+    SizedTrailEntry<N> &entry = trail.entry[trail.size];
+    Mask bit = Mask(1u << (digit - 1));
+
+    if (!(board.cand[cell] & bit))
+        return false;
+
+    entry.cell = typename G::Index(cell);
+    entry.digit = (unsigned char)digit;
+    entry.cand = board.cand[cell];
+    entry.peers = 0;
+
+    for (int p = 0; p < G::PEERS; p++)
+    {
+        Mask &peer = board.cand[tables.peer[cell][p]];
+
+        entry.peers |= uint64_t((peer & bit) != 0) << p;
+        peer &= Mask(~bit);
+    }
+
+    board.value[cell] = (unsigned char)digit;
+    board.cand[cell] = 0;
+    board.left--;
+
+    trail.size++;
+
+    return true;
+}// end bool placeDigit(SizedBoard<N> &board, SizedTrail<N> &trail,
+//                     int cell, int digit)
+
+
+
+/******************************************************************************/
+/**
+
+ Takes back every placement logged on trail since mark, the last first,
+ leaving the board as it was when the trail was at mark.
+
+**/
+/******************************************************************************/
+
+
+
+template <int N>
+void undoTrail(SizedBoard<N> &board, SizedTrail<N> &trail, int mark)
+{
+    typedef typename Geometry<N>::Mask Mask;
+
+    const Tables<N> &tables = Lookup<N>::tables;
+
+    while (trail.size > mark)
+    {
+        const SizedTrailEntry<N> &entry = trail.entry[--trail.size];
+        Mask bit = Mask(1u << (entry.digit - 1));
+
+        for (uint64_t peers = entry.peers; peers != 0; peers &= peers - 1)
+        {
+#if defined(__GNUC__)
+            int p = __builtin_ctzll(peers);
+#else
+            int p = 0;
+
+            while (!(peers & (uint64_t(1) << p)))
+                p++;
+#endif
+
+            board.cand[tables.peer[entry.cell][p]] |= bit;
+        }
+
+        board.value[entry.cell] = 0;
+        board.cand[entry.cell] = entry.cand;
+        board.left++;
+    }
+}// end void undoTrail(SizedBoard<N> &board, SizedTrail<N> &trail, int mark)
+
+
+
+/******************************************************************************/
+/**
+
+ Naked and hidden singles until nothing changes, as propagate() in search.h
+ does for 9x9. Returns false if the board runs into a contradiction. Every
+ number placed is logged on trail if there is one.
+
+**/
+/******************************************************************************/
+
+
+
+template <int N>
+static bool singles(SizedBoard<N> &board, SizedTrail<N> *trail)
+{
+    typedef Geometry<N> G;
+    typedef typename G::Mask Mask;
+
+    const Tables<N> &tables = Lookup<N>::tables;
+    bool change;
+
+
+    /// Places digit, through the trail if there is one
+    auto place = [&](int cell, int digit)
+    {
+        if (trail != NULL)
+            placeDigit(board, *trail, cell, digit);
+        else
+            placeDigit(board, cell, digit);
+    };
+
+    do
+    {
+        change = false;
+
+        /// Squares with only one potential number left
+        for (int cell = 0; cell < G::CELLS; cell++)
+        {
+            if (board.value[cell] != 0)
+                continue;
+
+            if (board.cand[cell] == 0)
+                return false;
+
+            if (maskCount(board.cand[cell]) == 1)
+            {
+                place(cell, maskFirst(board.cand[cell]));
+
+                change = true;
+            }
+        }
+
+
+        /// Numbers with only one potential square left in a unit
+        for (int unit = 0; unit < G::UNITS; unit++)
+        {
+            Mask once = 0, twice = 0, placed = 0, single;
+
+            for (int i = 0; i < G::SIDE; i++)
+            {
+                int cell = tables.unit[unit][i];
+
+                if (board.value[cell] != 0)
+                    placed |= Mask(1u << (board.value[cell] - 1));
+
+                twice |= once & board.cand[cell];
+                once |= board.cand[cell];
+            }
+
+            if ((once | placed) != G::ALL)
+                return false;
+
+            single = once & Mask(~twice);
+
+            for (int i = 0; i < G::SIDE && single; i++)
+            {
+                int cell = tables.unit[unit][i];
+                Mask here = board.cand[cell] & single;
+
+                if (here == 0)
+                    continue;
+
+                /// Two numbers that both need this square
+                if (maskCount(here) > 1)
+                    return false;
+
+                place(cell, maskFirst(here));
+
+                single &= Mask(~here);
+
+                change = true;
+            }
+
+        }// end for (int unit = 0; unit < G::UNITS; unit++)
+
+    }
+    while (change);
+
+    return true;
+}// end static bool singles(SizedBoard<N> &board, SizedTrail<N> *trail)
+
+
+
+/// Naked and hidden singles with nothing logged
+template <int N>
+bool propagate(SizedBoard<N> &board)
+{
+    return singles(board, (SizedTrail<N> *)NULL);
+}
+
+
+
+/// The empty square with the fewest potential numbers
+template <int N>
+static int fewestCandidates(const SizedBoard<N> &board)
+{
+    int best = -1, fewest = Geometry<N>::SIDE + 1;
+
+    for (int cell = 0; cell < Geometry<N>::CELLS && fewest > 2; cell++)
+    {
+        if (board.value[cell] == 0 && maskCount(board.cand[cell]) < fewest)
+        {
+            best = cell;
+            fewest = maskCount(board.cand[cell]);
+        }
+    }
+
+    return best;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Depth first search, the same as depthFirst() in search.h: logic, then a
+ guess on the square with the fewest potential numbers. Everything is placed
+ through the trail, and a dead end is backed out of with undoTrail(), so
+ the one board is used all the way down. Returns true with the board
+ solved, or false, with the board as it was, if there is no solution.
+ Guesses and backtracks are spent from budget, if there is one; once it
+ runs out the search unwinds, leaving the board from the top of the search
+ (depth 0) with what logic placed on it.
+
+**/
+/******************************************************************************/
+
+
+
+template <int N>
+static bool searchFrom(SizedBoard<N> &board, SizedTrail<N> &trail,
+                       Budget *budget, int depth)
+{
+    typedef typename Geometry<N>::Mask Mask;
+
+    int mark = trail.size, best;
+
+    if (!singles(board, &trail))
+    {
+        undoTrail(board, trail, mark);
+        return false;
+    }
+
+    if (board.left == 0)
+        return true;
+
+    best = fewestCandidates(board);
+
+    for (Mask mask = board.cand[best]; mask; mask &= mask - 1)
+    {
+        int guess = trail.size;
+
+        if (budget != NULL && !spendNode(*budget))
+            break;
+
+        placeDigit(board, trail, best, maskFirst(mask));
+
+        if (searchFrom(board, trail, budget, depth + 1))
+            return true;
+
+        undoTrail(board, trail, guess);
+
+        if (budget != NULL && !spendRestart(*budget))
+            break;
+    }
+
+    if (depth > 0 || budget == NULL || !budget->exhausted)
+        undoTrail(board, trail, mark);
+
+    return false;
+}// end static bool searchFrom(SizedBoard<N> &board, SizedTrail<N> &trail,
+//                             Budget *budget, int depth)
+
+
+
+/// Depth first search with no budget
+template <int N>
+bool depthFirst(SizedBoard<N> &board)
+{
+    SizedTrail<N> trail;
+
+    trail.size = 0;
+
+    return searchFrom(board, trail, (Budget *)NULL, 0);
+}
+
+
+
+/// Depth first search within budget: SOLVE_SOLVED with the board solved,
+/// SOLVE_UNSOLVABLE with it unchanged, or SOLVE_EXHAUSTED with what logic
+/// placed before the first guess
+template <int N>
+SolveStatus depthFirst(SizedBoard<N> &board, Budget &budget)
+{
+    SizedTrail<N> trail;
+
+    trail.size = 0;
+
+    if (searchFrom(board, trail, &budget, 0))
+        return SOLVE_SOLVED;
+
+    return budget.exhausted ? SOLVE_EXHAUSTED : SOLVE_UNSOLVABLE;
+}
+
+
+
+/// Adds the solutions found from this board on to count, up to limit, and
+/// gives up if budget, if there is one, runs out. The board is put back as
+/// it was through the trail.
+template <int N>
+static void countFrom(SizedBoard<N> &board, SizedTrail<N> &trail, int limit,
+                      int &count, Budget *budget)
+{
+    typedef typename Geometry<N>::Mask Mask;
+
+    int mark = trail.size, best;
+
+    if (!singles(board, &trail))
+    {
+        undoTrail(board, trail, mark);
+        return;
+    }
+
+    if (board.left == 0)
+    {
+        count++;
+        undoTrail(board, trail, mark);
+        return;
+    }
+
+    best = fewestCandidates(board);
+
+    for (Mask mask = board.cand[best]; mask && count < limit; mask &= mask - 1)
+    {
+        int guess = trail.size;
+
+        if (budget != NULL && !spendNode(*budget))
+            break;
+
+        placeDigit(board, trail, best, maskFirst(mask));
+
+        countFrom(board, trail, limit, count, budget);
+
+        undoTrail(board, trail, guess);
+    }
+
+    undoTrail(board, trail, mark);
+}// end static void countFrom(SizedBoard<N> &board, SizedTrail<N> &trail,
+//                            int limit, int &count, Budget *budget)
+
+
+
+/******************************************************************************/
+/**
+
+ Counts the solutions of the board, stopping once limit of them have been
+ found. The board is left unchanged.
+
+**/
+/******************************************************************************/
+
+
+
+template <int N>
+int countSolutions(const SizedBoard<N> &board, int limit)
+{
+    SizedBoard<N> work = board;
+    SizedTrail<N> trail;
+    int count = 0;
+
+    trail.size = 0;
+
+    if (limit > 0)
+        countFrom(work, trail, limit, count, (Budget *)NULL);
+
+    return count;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Counts solutions the same way within budget. If the budget runs out the
+ count is of the solutions found until then, and budget.exhausted is set.
+
+**/
+/******************************************************************************/
+
+
+
+template <int N>
+int countSolutions(const SizedBoard<N> &board, int limit, Budget &budget)
+{
+    SizedBoard<N> work = board;
+    SizedTrail<N> trail;
+    int count = 0;
+
+    trail.size = 0;
+
+    if (limit > 0)
+        countFrom(work, trail, limit, count, &budget);
+
+    return count;
+}
+
+
+
+/// The sizes built: 4x4, 9x9, 16x16 and 25x25
+#define SIZED_INSTANTIATE(N)                                                  \
+    template bool parseSized<N>(const char *, size_t, int [], string &);      \
+    template void writeSized<N>(const SizedBoard<N> &, char *);               \
+    template bool initBoard<N>(SizedBoard<N> &, const int []);                \
+    template bool placeDigit<N>(SizedBoard<N> &, int, int);                   \
+    template bool placeDigit<N>(SizedBoard<N> &, SizedTrail<N> &, int, int);  \
+    template void undoTrail<N>(SizedBoard<N> &, SizedTrail<N> &, int);        \
+    template bool propagate<N>(SizedBoard<N> &);                              \
+    template bool depthFirst<N>(SizedBoard<N> &);                             \
+    template SolveStatus depthFirst<N>(SizedBoard<N> &, Budget &);            \
+    template int countSolutions<N>(const SizedBoard<N> &, int);               \
+    template int countSolutions<N>(const SizedBoard<N> &, int, Budget &);
+
+SIZED_INSTANTIATE(2)
+SIZED_INSTANTIATE(3)
+SIZED_INSTANTIATE(4)
+SIZED_INSTANTIATE(5)
@@ -0,0 +1,103 @@
+/**
+  Name: sized.h
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Boards of any size, picked at compile time by the box order N:
+  a board is N^2 x N^2 squares made of N x N grids, so N = 2 is 4x4, 3 is
+  9x9, 4 is 16x16 and 5 is 25x25. Each size gets its own board, tables and
+  search, the same logic and depth first search as search.h.
+
+  The rows, columns, grids and peers of every square are worked out by the
+  compiler (geometry.h), so every loop over them has a fixed length known at
+  compile time. Masks of potential numbers are 16 bits up to 16x16 and 32 bits
+  for 25x25.
+
+  Puzzles are one line of N^4 characters, left to right and top to bottom:
+  '1' - '9' for the numbers 1 - 9, 'A' - 'P' (or 'a' - 'p') for 10 - 25, and
+  '0' or '.' for an empty square. Sizes 2, 3, 4 and 5 are built.
+
+  Placements can be made through a trail, as on the 9x9 board (board.h), so
+  undoTrail() takes them back without copying the board. That is how the
+  search backtracks: one board per search, whatever its depth.
+
+  depthFirst() and countSolutions() can be held to a budget (budget.h) the
+  same as search.h's.
+*/
+
+#ifndef SIZED_H
+#define SIZED_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "budget.h"
+#include "geometry.h"
+
+template <int N>
+struct SizedBoard
+{
+    typedef Geometry<N> G;
+
+    unsigned char value[G::CELLS];          // 0 for an empty square
+    typename G::Mask cand[G::CELLS];        // potential numbers, 0 once filled
+    int left;                               // empty squares remaining
+};
+
+/// One placement made through a trail, enough to take it back
+template <int N>
+struct SizedTrailEntry
+{
+    typedef Geometry<N> G;
+
+    typename G::Index cell;
+    unsigned char digit;
+    typename G::Mask cand;                  // the square's potential numbers
+                                            // before the placement
+    uint64_t peers;                         // bit p for tables.peer[cell][p]
+                                            // losing digit to it
+
+    static_assert(G::PEERS <= 64, "peers must fit in 64 bits");
+};
+
+/// Every square can be placed once, so that is as long as a trail gets
+template <int N>
+struct SizedTrail
+{
+    SizedTrailEntry<N> entry[Geometry<N>::CELLS];
+    int size;                               // also the mark for what comes
+                                            // next
+};
+
+/// Box order of a puzzle line going by its length, 0 if it is no size built
+int puzzleOrder(const char *text, size_t length);
+
+template <int N>
+bool parseSized(const char *text, size_t length, int values[],
+                std::string &error);
+template <int N>
+void writeSized(const SizedBoard<N> &board, char *out);
+
+template <int N>
+bool initBoard(SizedBoard<N> &board, const int values[]);
+template <int N>
+bool placeDigit(SizedBoard<N> &board, int cell, int digit);
+template <int N>
+bool placeDigit(SizedBoard<N> &board, SizedTrail<N> &trail, int cell,
+                int digit);
+template <int N>
+void undoTrail(SizedBoard<N> &board, SizedTrail<N> &trail, int mark);
+
+template <int N>
+bool propagate(SizedBoard<N> &board);
+template <int N>
+bool depthFirst(SizedBoard<N> &board);
+template <int N>
+SolveStatus depthFirst(SizedBoard<N> &board, Budget &budget);
+template <int N>
+int countSolutions(const SizedBoard<N> &board, int limit);
+template <int N>
+int countSolutions(const SizedBoard<N> &board, int limit, Budget &budget);
+
+#endif // SIZED_H
@@ -0,0 +1,31 @@
+#!/bin/sh
+# Solves the corpus in batch with every engine, on one thread and on
+# several, in order and numbered (-u), and checks every line against the
+# known solutions.
+
+sudoku=$1
+dir=$2
+status=0
+
+for engine in dfs dlx simd
+do
+    for threads in 1 3
+    do
+        if ! "$sudoku" -b "$dir/corpus.txt" -e $engine -t $threads \
+                2>/dev/null | diff "$dir/corpus.solutions" -
+        then
+            echo "-e $engine -t $threads: wrong output"
+            status=1
+        fi
+
+        if ! "$sudoku" -b "$dir/corpus.txt" -e $engine -t $threads -u \
+                2>/dev/null | sort -n | cut -d ' ' -f 2- |
+                diff "$dir/corpus.solutions" -
+        then
+            echo "-e $engine -t $threads -u: wrong output"
+            status=1
+        fi
+    done
+done
+
+exit $status
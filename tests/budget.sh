@@ -0,0 +1,41 @@
+#!/bin/sh
+# Gives a puzzle that needs a search a budget of one guess, in batch and
+# alone with depth first search, and one restart alone with brute force,
+# and checks that each gives up and says so.
+
+sudoku=$1
+dir=$2
+status=0
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+sed -n 3p "$dir/corpus.txt" > "$work/hard.txt"
+
+output=$("$sudoku" -b "$work/hard.txt" -n 1 2>"$work/summary")
+
+case "$output" in
+    "budget exhausted "*) ;;
+    *) echo "-b -n 1: expected budget exhausted, got $output"; status=1 ;;
+esac
+
+if ! grep -q ", 1 out of budget" "$work/summary"
+then
+    echo "-b -n 1: summary does not count it: $(cat "$work/summary")"
+    status=1
+fi
+
+
+# The single puzzle mode reads data.txt, nine lines of nine squares
+sed 's/\(.\{9\}\)/\1\
+/g' "$work/hard.txt" | tr . ' ' | head -n 9 > "$work/data.txt"
+
+for limit in "-e dfs -n 1" "-e brute -R 1 -s 1"
+do
+    if ! (cd "$work" && "$sudoku" $limit) | grep -q "^Out of budget"
+    then
+        echo "$limit: did not run out of budget"
+        status=1
+    fi
+done
+
+exit $status
@@ -0,0 +1,25 @@
+#!/bin/sh
+# Counts the solutions of a puzzle with one, one with none, one with two and
+# the empty board, with -c alone, which stops at 2, and with a limit.
+
+sudoku=$1
+dir=$2
+status=0
+
+check()
+{
+    if [ "$2" != "$3" ]
+    then
+        echo "$1: expected $2, got $3"
+        status=1
+    fi
+}
+
+check "-c" "1 0 2 2" \
+      "$(echo $("$sudoku" -b "$dir/counts.txt" -c 2>/dev/null))"
+check "-c 10" "1 0 2 10" \
+      "$(echo $("$sudoku" -b "$dir/counts.txt" -c 10 -t 2 2>/dev/null))"
+check "-c 1" "1 0 1 1" \
+      "$(echo $("$sudoku" -b "$dir/counts.txt" -c 1 2>/dev/null))"
+
+exit $status
@@ -0,0 +1,38 @@
+#!/bin/sh
+# Sends the daemon, on standard input, one request for each reply code: a
+# puzzle it solves, one with no solution, a line that is not a puzzle, an
+# unknown command and a puzzle that needs more than the one guess allowed.
+
+sudoku=$1
+dir=$2
+status=0
+solved=$(sed -n 7p "$dir/corpus.txt")
+unsolvable=$(sed -n 8p "$dir/corpus.txt")
+hard=$(sed -n 2p "$dir/corpus.txt")
+
+replies=$(printf '%s\n%s\n12\nFOO\n%s\nPING\nQUIT\n' \
+                 "$solved" "$unsolvable" "$hard" |
+          "$sudoku" -d - -t 2 -n 1) || status=1
+
+codes=$(echo $(echo "$replies" | cut -d ' ' -f 1))
+
+if [ "$codes" != "0 1 2 3 4 0" ]
+then
+    echo "expected reply codes 0 1 2 3 4 0, got $codes"
+    status=1
+fi
+
+if [ "$(echo "$replies" | sed -n 1p)" != \
+     "0 $(sed -n 7p "$dir/corpus.solutions")" ]
+then
+    echo "wrong solution: $(echo "$replies" | sed -n 1p)"
+    status=1
+fi
+
+if [ "$(echo "$replies" | sed -n 2p)" != "1 no solution" ]
+then
+    echo "expected 1 no solution, got $(echo "$replies" | sed -n 2p)"
+    status=1
+fi
+
+exit $status
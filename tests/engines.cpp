@@ -0,0 +1,249 @@
+/**
+  Name: engines.cpp
+  Copyright:
+  Author:
+  Date: 10/18/2026
+  Description: Checks that every way of solving a puzzle gives the same
+  answer. Each puzzle of a corpus (corpus.h format) is solved with logic
+  alone, solve() from logic.cpp, with depthFirst() (search.h), with Dancing
+  Links (dlx.h) and 16 at a time with solveLanes() (simd.h), and each answer
+  is checked against the line of the solutions file for that puzzle: its
+  solution, or "no solution". Logic alone may stop short of a solution, but
+  must not report one that is wrong.
+
+  Usage: engines corpus solutions
+
+  Prints a line for every answer that does not match and returns 1 if there
+  were any, so it can be run by CTest (see CMakeLists.txt).
+*/
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "board.h"
+#include "corpus.h"
+#include "dlx.h"
+#include "logic.h"
+#include "search.h"
+#include "simd.h"
+
+using namespace std;
+
+const string NO_SOLUTION = "no solution";
+
+struct Puzzle
+{
+    int arr[SIDE][SIDE];
+    string expected;                // the solution, or NO_SOLUTION
+};
+
+
+
+/******************************************************************************/
+/**
+
+ Reads every puzzle of corpusName into corpus, with the matching line of
+ solutionsName. Returns false, saying why, if either file cannot be read,
+ a line is not a puzzle or the files have different numbers of lines.
+
+**/
+/******************************************************************************/
+
+
+
+bool loadPuzzles(const char *corpusName, const char *solutionsName,
+                 vector<Puzzle> &corpus)
+{
+    ifstream puzzles(corpusName), solutions(solutionsName);
+    string line, error;
+
+    if (!puzzles.is_open() || !solutions.is_open())
+    {
+        cerr << "unable to open " << corpusName << " or " << solutionsName
+             << endl;
+        return false;
+    }
+
+    while (getline(puzzles, line))
+    {
+        Puzzle puzzle;
+
+        if (!parsePuzzle(line.data(), line.size(), puzzle.arr, error))
+        {
+            cerr << corpusName << " line " << corpus.size() + 1 << ": "
+                 << error << endl;
+            return false;
+        }
+
+        if (!getline(solutions, puzzle.expected))
+        {
+            cerr << solutionsName << " has fewer lines than " << corpusName
+                 << endl;
+            return false;
+        }
+
+        corpus.push_back(puzzle);
+    }
+
+    if (getline(solutions, line))
+    {
+        cerr << solutionsName << " has more lines than " << corpusName
+             << endl;
+        return false;
+    }
+
+    return true;
+}// end bool loadPuzzles(const char *corpusName, const char *solutionsName,
+//                      vector<Puzzle> &corpus)
+
+
+
+/******************************************************************************/
+/**
+
+ The one line answer for a puzzle: its solution in arr if solved, else
+ NO_SOLUTION.
+
+**/
+/******************************************************************************/
+
+
+
+string answer(bool solved, int arr[][SIDE])
+{
+    Board board;
+    char line[CELLS];
+
+    if (!solved)
+        return NO_SOLUTION;
+
+    for (int cell = 0; cell < CELLS; cell++)
+        board.value[cell] = arr[rowOf(cell)][colOf(cell)];
+
+    writeBoard(board, line);
+
+    return string(line, CELLS);
+}// end string answer(bool solved, int arr[][SIDE])
+
+
+
+/******************************************************************************/
+/**
+
+ Says which engine got which puzzle wrong, and what it answered.
+
+**/
+/******************************************************************************/
+
+
+
+bool check(const char *engine, size_t i, const Puzzle &puzzle,
+           const string &got)
+{
+    if (got == puzzle.expected)
+        return true;
+
+    cout << engine << " puzzle " << i + 1 << ": expected " << puzzle.expected
+         << ", got " << got << endl;
+
+    return false;
+}// end bool check(const char *engine, size_t i, const Puzzle &puzzle,
+//                const string &got)
+
+
+
+/******************************************************************************/
+
+int main(int argc, char *argv[])
+{
+    vector<Puzzle> corpus;
+    static Dlx dlx;
+    int failures = 0;
+
+    if (argc != 3)
+    {
+        cerr << "usage: " << argv[0] << " corpus solutions" << endl;
+        return 1;
+    }
+
+    if (!loadPuzzles(argv[1], argv[2], corpus))
+        return 1;
+
+    initDlx(dlx);
+
+
+    /// solve() only has to be right when it says it solved the puzzle
+    for (size_t i = 0; i < corpus.size(); i++)
+    {
+        int arr[SIDE][SIDE], leftToSolve = 0;
+
+        memcpy(arr, corpus[i].arr, sizeof(arr));
+
+        for (int j = 0; j < SIDE; j++)
+            for (int k = 0; k < SIDE; k++)
+                if (arr[j][k] == 0)
+                    leftToSolve++;
+
+        if (solve(arr, leftToSolve) &&
+            !check("solve", i, corpus[i], answer(true, arr)))
+            failures++;
+    }
+
+    for (size_t i = 0; i < corpus.size(); i++)
+    {
+        int arr[SIDE][SIDE];
+
+        memcpy(arr, corpus[i].arr, sizeof(arr));
+
+        if (!check("dfs", i, corpus[i], answer(depthFirst(arr), arr)))
+            failures++;
+
+        memcpy(arr, corpus[i].arr, sizeof(arr));
+
+        if (!check("dlx", i, corpus[i], answer(dlxSolve(dlx, arr), arr)))
+            failures++;
+    }
+
+
+    /// Boards with clues that clash have no solution and never reach a lane
+    for (size_t i = 0; i < corpus.size(); i += LANES)
+    {
+        Board boards[LANES];
+        bool solved[LANES];
+        size_t lane[LANES];
+        int count = 0;
+
+        for (size_t j = i; j < corpus.size() && j < i + LANES; j++)
+        {
+            int arr[SIDE][SIDE];
+
+            memcpy(arr, corpus[j].arr, sizeof(arr));
+
+            if (initBoard(boards[count], arr))
+                lane[count++] = j;
+            else if (!check("simd", j, corpus[j], NO_SOLUTION))
+                failures++;
+        }
+
+        solveLanes(boards, count, solved);
+
+        for (int l = 0; l < count; l++)
+        {
+            char line[CELLS];
+
+            writeBoard(boards[l], line);
+
+            if (!check("simd", lane[l], corpus[lane[l]],
+                       solved[l] ? string(line, CELLS) : NO_SOLUTION))
+                failures++;
+        }
+    }
+
+    cout << corpus.size() << " puzzles, " << failures << " wrong answers"
+         << endl;
+
+    return failures > 0 ? 1 : 0;
+}
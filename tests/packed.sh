@@ -0,0 +1,48 @@
+#!/bin/sh
+# Packs the corpus and unpacks it again, solves the packed file in batch,
+# and checks that a file cut short in its header or its records, or with
+# bytes after its records, is refused with a non-zero exit by -x and -b.
+
+sudoku=$1
+dir=$2
+status=0
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+if ! "$sudoku" -p "$dir/corpus.txt" "$work/corpus.sdp" 2>/dev/null ||
+   ! "$sudoku" -x "$work/corpus.sdp" "$work/corpus.txt" 2>/dev/null ||
+   ! diff "$dir/corpus.txt" "$work/corpus.txt"
+then
+    echo "pack and unpack did not give the corpus back"
+    status=1
+fi
+
+if ! "$sudoku" -b "$work/corpus.sdp" -t 3 2>/dev/null |
+     diff "$dir/corpus.solutions" -
+then
+    echo "-b on the packed corpus: wrong output"
+    status=1
+fi
+
+
+# 16 bytes of header, then 41 bytes a puzzle
+head -c 10 "$work/corpus.sdp" > "$work/short-header.sdp"
+head -c 100 "$work/corpus.sdp" > "$work/short-records.sdp"
+cat "$work/corpus.sdp" "$work/corpus.sdp" > "$work/trailing-bytes.sdp"
+
+for bad in short-header short-records trailing-bytes
+do
+    if "$sudoku" -x "$work/$bad.sdp" "$work/$bad.txt" 2>/dev/null
+    then
+        echo "-x took $bad.sdp"
+        status=1
+    fi
+
+    if "$sudoku" -b "$work/$bad.sdp" >/dev/null 2>&1
+    then
+        echo "-b took $bad.sdp"
+        status=1
+    fi
+done
+
+exit $status
@@ -0,0 +1,153 @@
+/**
+  Name: trace.cpp
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: The trace sinks that do something. See trace.h.
+*/
+
+#include "logic.h"
+#include "trace.h"
+
+using namespace std;
+
+
+
+/******************************************************************************/
+/**
+
+ Name of a technique as shown by the text sinks.
+
+**/
+/******************************************************************************/
+
+
+
+const char *techniqueName(Technique technique)
+{
+    static const char *names[TECHNIQUES] =
+    {
+        "naked single", "hidden single", "pointing", "claiming",
+        "naked subset", "hidden subset", "x-wing", "swordfish", "jellyfish",
+        "guess"
+    };
+
+    return technique < TECHNIQUES ? names[technique] : "unknown";
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Draws the board and the number of empty squares left, the same output solve()
+ used to give after every number it placed.
+
+**/
+/******************************************************************************/
+
+
+
+void BoardTrace::place(const Board &board, int, int, Technique)
+{
+    int arr[SIDE][SIDE];
+
+    for (int cell = 0; cell < CELLS; cell++)
+        arr[rowOf(cell)][colOf(cell)] = board.value[cell];
+
+    display(arr, *out);
+
+    *out << board.left << endl;
+}
+
+
+
+void BoardTrace::guess(int cell, int digit, int depth)
+{
+    *out << "Guessing " << digit << " at row " << rowOf(cell) + 1
+         << ", column " << colOf(cell) + 1 << " (depth " << depth << ")"
+         << endl;
+}
+
+
+
+/******************************************************************************/
+/**
+
+ One line per event: r<row>c<column>=<number> for a placement,
+ r<row>c<column>-<number> for an elimination, followed by the technique.
+
+**/
+/******************************************************************************/
+
+
+
+void TextTrace::place(const Board &, int cell, int digit, Technique technique)
+{
+    *out << 'r' << rowOf(cell) + 1 << 'c' << colOf(cell) + 1 << '=' << digit
+         << ' ' << techniqueName(technique) << '\n';
+}
+
+
+
+void TextTrace::eliminate(const Board &, int cell, int digit,
+                          Technique technique)
+{
+    *out << 'r' << rowOf(cell) + 1 << 'c' << colOf(cell) + 1 << '-' << digit
+         << ' ' << techniqueName(technique) << '\n';
+}
+
+
+
+void TextTrace::guess(int cell, int digit, int depth)
+{
+    *out << 'r' << rowOf(cell) + 1 << 'c' << colOf(cell) + 1 << '?' << digit
+         << " guess " << depth << '\n';
+}
+
+
+
+/******************************************************************************/
+/**
+
+ Writes one 4 byte record.
+
+**/
+/******************************************************************************/
+
+
+
+static void writeRecord(ostream &out, int kind, int cell, int digit, int extra)
+{
+    char record[4];
+
+    record[0] = char(kind);
+    record[1] = char(cell);
+    record[2] = char(digit);
+    record[3] = char(extra);
+
+    out.write(record, 4);
+}
+
+
+
+void BinaryTrace::place(const Board &, int cell, int digit,
+                        Technique technique)
+{
+    writeRecord(*out, TRACE_PLACE, cell, digit, technique);
+}
+
+
+
+void BinaryTrace::eliminate(const Board &, int cell, int digit,
+                            Technique technique)
+{
+    writeRecord(*out, TRACE_ELIMINATE, cell, digit, technique);
+}
+
+
+
+void BinaryTrace::guess(int cell, int digit, int depth)
+{
+    writeRecord(*out, TRACE_GUESS, cell, digit, depth);
+}
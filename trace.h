@@ -0,0 +1,171 @@
+/**
+  Name: trace.h
+  Copyright:
+  Author:
+  Date: 10/17/2026
+  Description: Trace sinks. The solving functions take the sink as a template
+  parameter and tell it about every number placed, every potential number
+  eliminated and every guess made, along with the technique that did it.
+
+  NullTrace, the default, does nothing and its calls compile away, so a solve
+  with no trace costs exactly what it would without these calls at all. The
+  other sinks are only paid for when asked for:
+
+    BoardTrace    draws the board after every number placed, the way solve()
+                  used to
+    TextTrace     one short line per event, e.g. "r3c5=7 hidden single"
+    BinaryTrace   4 bytes per event: kind, square, number, technique or
+                  guess depth
+    CountTrace    how many events of each technique, and the deepest guess,
+                  for the grader (grader.h)
+    StepTrace     the first number placed or eliminated and nothing after
+                  it, for hints (hint.h)
+
+  Squares are numbered 0 - 80 (see board.h).
+*/
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <ostream>
+
+#include "board.h"
+
+enum Technique
+{
+    NAKED_SINGLE,               // only one potential number left on a square
+    HIDDEN_SINGLE,              // only one potential square left for a number
+    POINTING,                   // a number lined up in one row or column
+    CLAIMING,                   // a row or column's number in one 3x3 grid
+    NAKED_SUBSET,               // n squares of a unit with only n numbers
+    HIDDEN_SUBSET,              // n numbers of a unit with only n squares
+    X_WING,                     // a number on the same 2 columns of 2 rows
+    SWORDFISH,                  // the same with 3
+    JELLYFISH,                  // the same with 4
+    GUESS,                      // placed by a search
+    TECHNIQUES
+};
+
+/// Event kinds as written by BinaryTrace
+enum TraceEvent { TRACE_PLACE, TRACE_ELIMINATE, TRACE_GUESS };
+
+const char *techniqueName(Technique technique);
+
+
+
+struct NullTrace
+{
+    void place(const Board &, int, int, Technique) {}
+    void eliminate(const Board &, int, int, Technique) {}
+    void guess(int, int, int) {}
+};
+
+
+
+struct BoardTrace
+{
+    std::ostream *out;
+
+    explicit BoardTrace(std::ostream &out) : out(&out) {}
+
+    void place(const Board &board, int cell, int digit, Technique technique);
+    void eliminate(const Board &, int, int, Technique) {}
+    void guess(int cell, int digit, int depth);
+};
+
+
+
+struct TextTrace
+{
+    std::ostream *out;
+
+    explicit TextTrace(std::ostream &out) : out(&out) {}
+
+    void place(const Board &board, int cell, int digit, Technique technique);
+    void eliminate(const Board &board, int cell, int digit,
+                   Technique technique);
+    void guess(int cell, int digit, int depth);
+};
+
+
+
+struct BinaryTrace
+{
+    std::ostream *out;
+
+    explicit BinaryTrace(std::ostream &out) : out(&out) {}
+
+    void place(const Board &board, int cell, int digit, Technique technique);
+    void eliminate(const Board &board, int cell, int digit,
+                   Technique technique);
+    void guess(int cell, int digit, int depth);
+};
+
+
+
+struct CountTrace
+{
+    long uses[TECHNIQUES];          // numbers placed or eliminated by each
+    int depth;                      // deepest guess
+
+    CountTrace() : uses(), depth(0) {}
+
+    void place(const Board &, int, int, Technique technique)
+    {
+        uses[technique]++;
+    }
+
+    void eliminate(const Board &, int, int, Technique technique)
+    {
+        uses[technique]++;
+    }
+
+    void guess(int, int, int depth)
+    {
+        uses[GUESS]++;
+
+        if (depth > this->depth)
+            this->depth = depth;
+    }
+};
+
+
+
+struct StepTrace
+{
+    bool found;                     // false until the first event
+    bool placed;                    // true for a placement
+    int cell;
+    int digit;
+    Technique technique;
+
+    StepTrace()
+        : found(false), placed(false), cell(0), digit(0),
+          technique(NAKED_SINGLE) {}
+
+    void place(const Board &, int cell, int digit, Technique technique)
+    {
+        keep(true, cell, digit, technique);
+    }
+
+    void eliminate(const Board &, int cell, int digit, Technique technique)
+    {
+        keep(false, cell, digit, technique);
+    }
+
+    void guess(int, int, int) {}
+
+    void keep(bool placed, int cell, int digit, Technique technique)
+    {
+        if (found)
+            return;
+
+        found = true;
+        this->placed = placed;
+        this->cell = cell;
+        this->digit = digit;
+        this->technique = technique;
+    }
+};
+
+#endif // TRACE_H